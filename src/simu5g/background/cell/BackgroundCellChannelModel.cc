@@ -918,12 +918,15 @@ bool BackgroundCellChannelModel::computeDownlinkInterference(MacNodeId bgUeId, i
 
         txPwr = enb->txPwr - angularAtt - cableLoss_ + antennaGainEnB_ + antennaGainUe_;
 
+        // received power is the same on all the bands, linearize it once
+        double recvPwr = dBmToLinear(txPwr - att); //(dBm-dB)=dBm
+
         numBands = std::min(numBands, interfChanModel->getNumBands());
         for (unsigned int i = 0; i < numBands; i++) {
             // compute the number of occupied slot (unnecessary)
             temp = enb->mac->getDlBandStatus(i);
             if (temp != 0)
-                (*interference)[i] += dBmToLinear(txPwr - att); //(dBm-dB)=dBm
+                (*interference)[i] += recvPwr;
 
             EV << "\t band " << i << " occupied " << temp << "/pwr[" << txPwr << "]-int[" << (*interference)[i] << "]" << endl;
         }
@@ -937,9 +940,10 @@ bool BackgroundCellChannelModel::computeUplinkInterference(MacNodeId bgUeId, ine
 {
     EV << "**** Uplink Interference ****" << endl;
 
-    const std::vector<std::vector<UeAllocationInfo>> *ulTransmissionMap = binder_->getUlTransmissionMap(carrierFrequency, CURR_TTI);
-    if (ulTransmissionMap != nullptr && !ulTransmissionMap->empty()) {
-        for (unsigned int i = 0; i < numBands; i++) {
+    const UlTransmissionMap *ulTransmissionMap = binder_->getUlTransmissionMap(carrierFrequency, CURR_TTI);
+    if (ulTransmissionMap != nullptr) {
+        // only the bands used by at least one UE are checked
+        for (unsigned int i = ulTransmissionMap->nextOccupiedBand(0); i < numBands; i = ulTransmissionMap->nextOccupiedBand(i + 1)) {
             // get the set of UEs transmitting on the same band
             const std::vector<UeAllocationInfo>& allocatedUes = ulTransmissionMap->at(i);
             for (const auto& ueInfo : allocatedUes) {
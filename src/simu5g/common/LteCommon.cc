@@ -455,6 +455,100 @@ double dBToLinear(double db)
     return pow(10, (db) / 10);
 }
 
+namespace {
+
+// 2^y, with relative error below 1e-8
+inline double fastExp2(double y)
+{
+    double n = nearbyint(y);
+    double f = (y - n) * M_LN2; // |f| <= ln(2)/2
+    // Taylor expansion of e^f up to the 7th order
+    double p = 1.0 + f * (1.0 + f * (1.0 / 2 + f * (1.0 / 6 + f * (1.0 / 24 + f * (1.0 / 120 + f * (1.0 / 720 + f * (1.0 / 5040)))))));
+    return ldexp(p, (int)n);
+}
+
+// log2(x) for finite x > 0, with absolute error below 1e-9
+inline double fastLog2(double x)
+{
+    int e;
+    double m = frexp(x, &e); // m in [0.5,1)
+    if (m < M_SQRT1_2) {
+        m *= 2;
+        e--;
+    }
+    // ln(m) = 2 * atanh(t), with |t| <= 0.172
+    double t = (m - 1) / (m + 1);
+    double t2 = t * t;
+    double lnm = 2 * t * (1 + t2 * (1.0 / 3 + t2 * (1.0 / 5 + t2 * (1.0 / 7 + t2 * (1.0 / 9)))));
+    return e + lnm * M_LOG2E;
+}
+
+// 10^(db/10)
+inline double fastDbToLinear(double db)
+{
+    if (!std::isfinite(db))
+        return pow(10, db / 10);
+    return fastExp2(db * (M_LN10 / M_LN2 / 10));
+}
+
+// 10*log10(linear)
+inline double fastLinearToDb(double linear)
+{
+    if (!(linear > 0) || !std::isfinite(linear))
+        return 10 * log10(linear);
+    return fastLog2(linear) * (10 * M_LN2 / M_LN10);
+}
+
+} // namespace
+
+void dBmToLinear(const double *dbm, double *lin, unsigned int n, bool fast)
+{
+    if (fast) {
+        for (unsigned int i = 0; i < n; i++)
+            lin[i] = fastDbToLinear(dbm[i] - 30);
+    }
+    else {
+        for (unsigned int i = 0; i < n; i++)
+            lin[i] = dBmToLinear(dbm[i]);
+    }
+}
+
+void dBToLinear(const double *db, double *lin, unsigned int n, bool fast)
+{
+    if (fast) {
+        for (unsigned int i = 0; i < n; i++)
+            lin[i] = fastDbToLinear(db[i]);
+    }
+    else {
+        for (unsigned int i = 0; i < n; i++)
+            lin[i] = dBToLinear(db[i]);
+    }
+}
+
+void linearToDBm(const double *lin, double *dbm, unsigned int n, bool fast)
+{
+    if (fast) {
+        for (unsigned int i = 0; i < n; i++)
+            dbm[i] = fastLinearToDb(1000 * lin[i]);
+    }
+    else {
+        for (unsigned int i = 0; i < n; i++)
+            dbm[i] = linearToDBm(lin[i]);
+    }
+}
+
+void linearToDb(const double *lin, double *db, unsigned int n, bool fast)
+{
+    if (fast) {
+        for (unsigned int i = 0; i < n; i++)
+            db[i] = fastLinearToDb(lin[i]);
+    }
+    else {
+        for (unsigned int i = 0; i < n; i++)
+            db[i] = linearToDb(lin[i]);
+    }
+}
+
 void initializeAllChannels(cModule *mod)
 {
     for (cModule::GateIterator i(mod); !i.end(); i++) {
@@ -143,6 +143,20 @@ double dBToLinear(double db);
 double linearToDBm(double lin);
 double linearToDb(double lin);
 
+/*
+ * Batched versions of the above conversions, converting the n values of "in" into "out"
+ * (in and out may be the same array).
+ * If fast is false, the result is the same as calling the scalar functions.
+ * If fast is true, pow() and log10() are replaced by exp2/log2 approximations:
+ * the relative error of dB->linear conversions is below 1e-8 and the absolute error
+ * of linear->dB conversions is below 1e-8 dB. Non-positive linear values and
+ * non-finite values are always converted with the exact functions.
+ */
+void dBmToLinear(const double *dbm, double *lin, unsigned int n, bool fast = false);
+void dBToLinear(const double *db, double *lin, unsigned int n, bool fast = false);
+void linearToDBm(const double *lin, double *dbm, unsigned int n, bool fast = false);
+void linearToDb(const double *lin, double *db, unsigned int n, bool fast = false);
+
 
 /*****************
 * X2 Support
@@ -333,6 +347,62 @@ struct UeAllocationInfo {
     Direction dir;
 };
 
+// UEs transmitting in UL on each band of a carrier, within one TTI
+struct UlTransmissionMap {
+    // UEs transmitting on each band
+    std::vector<std::vector<UeAllocationInfo>> bands;
+    // bitmap of the bands used by at least one UE
+    std::vector<uint64_t> occupied;
+    // false if no transmission has been stored for the TTI
+    bool valid = false;
+
+    // removes all the transmissions, retaining the allocated memory
+    void reset(unsigned int numBands)
+    {
+        bands.resize(numBands);
+        for (auto& ues : bands)
+            ues.clear();
+        occupied.assign((numBands + 63) / 64, 0);
+    }
+
+    void add(unsigned int band, const UeAllocationInfo& info)
+    {
+        bands.at(band).push_back(info);
+        occupied[band / 64] |= uint64_t(1) << (band % 64);
+    }
+
+    // removes the transmissions of the given node
+    void remove(MacNodeId nodeId)
+    {
+        for (unsigned int band = nextOccupiedBand(0); band < bands.size(); band = nextOccupiedBand(band + 1)) {
+            auto& ues = bands[band];
+            ues.erase(std::remove_if(ues.begin(), ues.end(), [nodeId](const UeAllocationInfo& info) { return info.nodeId == nodeId; }), ues.end());
+            if (ues.empty())
+                occupied[band / 64] &= ~(uint64_t(1) << (band % 64));
+        }
+    }
+
+    // returns the first band from the given one (included) used by at least one UE, or the number of bands if none
+    unsigned int nextOccupiedBand(unsigned int band) const
+    {
+        while (band < bands.size()) {
+            uint64_t word = occupied[band / 64] >> (band % 64);
+            if (word == 0) {
+                band = (band / 64 + 1) * 64;
+                continue;
+            }
+            while ((word & 1) == 0) {
+                word >>= 1;
+                band++;
+            }
+            return band;
+        }
+        return bands.size();
+    }
+
+    const std::vector<UeAllocationInfo>& at(unsigned int band) const { return bands.at(band); }
+};
+
 typedef std::vector<ExtCell *> ExtCellList;
 typedef std::vector<BackgroundScheduler *> BackgroundSchedulerList;
 
@@ -21,6 +21,7 @@
 #include "simu5g/corenetwork/statsCollector/UeStatsCollector.h"
 #include "simu5g/stack/mac/LteMacUe.h"
 #include "simu5g/stack/phy/LtePhyUe.h"
+#include "simu5g/stack/phy/channelmodel/LteRealisticChannelModel.h"
 #include "simu5g/common/cellInfo/CellInfo.h"
 #include "simu5g/stack/rrc/Rrc.h"
 
@@ -192,19 +193,20 @@ void Binder::unregisterNode(MacNodeId id)
     if (nodeInfoMap_.erase(id) != 1) {
         throw cRuntimeError("Cannot unregister node - node id %d - not found", num(id));
     }
+
+    // remove 'id' from the UE indices
+    if (num(id) < ueInfoIndex_.size())
+        ueInfoIndex_[num(id)] = nullptr;
+    for (auto& [carrierFrequency, channelModels] : ueChannelModelIndex_) {
+        if (num(id) < channelModels.size())
+            channelModels[num(id)] = nullptr;
+    }
+
     // remove 'id' from ulTransmissionMap_ if currently scheduled
-    for (auto& carrier : ulTransmissionMap_) { // all carrier frequency
-        for (auto& bands : carrier.second) { // all RB's for current and last TTI (vector<vector<vector<UeAllocationInfo>>>)
-            for (auto& ues : bands) { // all Ue's in each block
-                for(auto itr = ues.begin(); itr != ues.end(); ) {
-                    if (itr->nodeId == id) {
-                        itr = ues.erase(itr);
-                    }
-                    else {
-                        itr++;
-                    }
-                }
-            }
+    for (auto& [carrierFrequency, ring] : ulTransmissionMap_) { // all carrier frequency
+        for (auto& slot : ring.slots) { // current and last TTI
+            if (slot.valid)
+                slot.remove(id);
         }
     }
 }
@@ -495,10 +497,11 @@ void Binder::initAndResetUlTransmissionInfo()
         return;
     }
 
-    for (auto& [timeSlot, transmissions] : ulTransmissionMap_) {
-        // the second element (i.e., referring to the old time slot) becomes the first element
-        if (!transmissions.empty())
-            transmissions.erase(transmissions.begin());
+    for (auto& [carrierFrequency, ring] : ulTransmissionMap_) {
+        // the current slot becomes the previous one, and the slot of the old time slot is reused
+        // for the new one. Its content is cleared on the first store
+        ring.curr ^= 1;
+        ring.slots[ring.curr].valid = false;
     }
     lastUpdateUplinkTransmissionInfo_ = NOW;
 }
@@ -512,22 +515,17 @@ void Binder::storeUlTransmissionMap(GHz carrierFreq, Remote antenna, RbMap& rbMa
     info.dir = dir;
     info.trafficGen = nullptr;
 
-    if (ulTransmissionMap_.find(carrierFreq) == ulTransmissionMap_.end() || ulTransmissionMap_[carrierFreq].size() == 0) {
-        int numCarrierBands = componentCarriers_[carrierFreq].numBands;
-        ulTransmissionMap_[carrierFreq].resize(2);
-        ulTransmissionMap_[carrierFreq][PREV_TTI].resize(numCarrierBands);
-        ulTransmissionMap_[carrierFreq][CURR_TTI].resize(numCarrierBands);
-    }
-    else if (ulTransmissionMap_[carrierFreq].size() == 1) {
-        int numCarrierBands = componentCarriers_[carrierFreq].numBands;
-        ulTransmissionMap_[carrierFreq].push_back(std::vector<std::vector<UeAllocationInfo>>());
-        ulTransmissionMap_[carrierFreq][CURR_TTI].resize(numCarrierBands);
+    UplinkTransmissionRing& ring = ulTransmissionMap_[carrierFreq];
+    UlTransmissionMap& transmissions = ring.slots[ring.curr];
+    if (!transmissions.valid) {
+        transmissions.reset(componentCarriers_[carrierFreq].numBands);
+        transmissions.valid = true;
     }
 
     // for each allocated band, store the UE info
     for (const auto& [band, allocation] : rbMap[antenna]) {
         if (allocation > 0)
-            ulTransmissionMap_[carrierFreq][CURR_TTI][band].push_back(info);
+            transmissions.add(band, info);
     }
 
     lastUplinkTransmission_ = NOW;
@@ -542,34 +540,31 @@ void Binder::storeUlTransmissionMap(GHz carrierFreq, Remote antenna, RbMap& rbMa
     info.dir = dir;
     info.trafficGen = trafficGen;
 
-    if (ulTransmissionMap_.find(carrierFreq) == ulTransmissionMap_.end() || ulTransmissionMap_[carrierFreq].size() == 0) {
-        int numCarrierBands = componentCarriers_[carrierFreq].numBands;
-        ulTransmissionMap_[carrierFreq].resize(2);
-        ulTransmissionMap_[carrierFreq][PREV_TTI].resize(numCarrierBands);
-        ulTransmissionMap_[carrierFreq][CURR_TTI].resize(numCarrierBands);
-    }
-    else if (ulTransmissionMap_[carrierFreq].size() == 1) {
-        int numCarrierBands = componentCarriers_[carrierFreq].numBands;
-        ulTransmissionMap_[carrierFreq].push_back(std::vector<std::vector<UeAllocationInfo>>());
-        ulTransmissionMap_[carrierFreq][CURR_TTI].resize(numCarrierBands);
+    UplinkTransmissionRing& ring = ulTransmissionMap_[carrierFreq];
+    UlTransmissionMap& transmissions = ring.slots[ring.curr];
+    if (!transmissions.valid) {
+        transmissions.reset(componentCarriers_[carrierFreq].numBands);
+        transmissions.valid = true;
     }
 
     // for each allocated band, store the UE info
     for (const auto& [band, allocation] : rbMap[antenna]) {
         if (allocation > 0)
-            ulTransmissionMap_[carrierFreq][CURR_TTI][band].push_back(info);
+            transmissions.add(band, info);
     }
 
     lastUplinkTransmission_ = NOW;
 }
 
-const std::vector<std::vector<UeAllocationInfo>> *Binder::getUlTransmissionMap(GHz carrierFreq, UlTransmissionMapTTI t)
+const UlTransmissionMap *Binder::getUlTransmissionMap(GHz carrierFreq, UlTransmissionMapTTI t)
 {
-    if (ulTransmissionMap_.find(carrierFreq) == ulTransmissionMap_.end() || t >= ulTransmissionMap_[carrierFreq].size()) {
+    auto it = ulTransmissionMap_.find(carrierFreq);
+    if (it == ulTransmissionMap_.end())
         return nullptr;
-    }
 
-    return &(ulTransmissionMap_[carrierFreq].at(t));
+    const UplinkTransmissionRing& ring = it->second;
+    const UlTransmissionMap& transmissions = ring.slots[(t == CURR_TTI) ? ring.curr : ring.curr ^ 1];
+    return transmissions.valid ? &transmissions : nullptr;
 }
 
 void Binder::registerX2Port(X2NodeId nodeId, int port)
@@ -726,16 +721,49 @@ std::set<MacNodeId>& Binder::getD2DMulticastTransmitters()
     return multicastTransmitterSet_;
 }
 
-void Binder::updateUeInfoCellId(MacNodeId id, MacCellId newCellId)
+void Binder::addUeInfo(UeInfo *info)
 {
-    for (UeInfo *ue : ueList_) {
-        if (ue->id == id) {
-            ue->cellId = newCellId;
-            return;
-        }
+    ueList_.push_back(info);
+
+    unsigned short index = num(info->id);
+    if (ueInfoIndex_.size() <= index)
+        ueInfoIndex_.resize(index + 1, nullptr);
+    ueInfoIndex_[index] = info;
+
+    // channel models will be resolved on first access
+    for (auto& [carrierFrequency, channelModels] : ueChannelModelIndex_) {
+        if (index < channelModels.size())
+            channelModels[index] = nullptr;
     }
 }
 
+LteRealisticChannelModel *Binder::getUeRealisticChannelModel(MacNodeId ueId, GHz carrierFrequency)
+{
+    std::vector<LteRealisticChannelModel *>& channelModels = ueChannelModelIndex_[carrierFrequency];
+    unsigned short index = num(ueId);
+    if (index < channelModels.size() && channelModels[index] != nullptr)
+        return channelModels[index];
+
+    UeInfo *info = getUeInfo(ueId);
+    if (info == nullptr || info->phy == nullptr)
+        return nullptr;
+
+    LteRealisticChannelModel *channelModel = dynamic_cast<LteRealisticChannelModel *>(info->phy->getChannelModel(carrierFrequency));
+    if (channelModel != nullptr) {
+        if (channelModels.size() <= index)
+            channelModels.resize(index + 1, nullptr);
+        channelModels[index] = channelModel;
+    }
+    return channelModel;
+}
+
+void Binder::updateUeInfoCellId(MacNodeId id, MacCellId newCellId)
+{
+    UeInfo *ue = getUeInfo(id);
+    if (ue != nullptr)
+        ue->cellId = newCellId;
+}
+
 void Binder::addUeHandoverTriggered(MacNodeId nodeId)
 {
     ueHandoverTriggered_.insert(nodeId);
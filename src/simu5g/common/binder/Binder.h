@@ -79,6 +79,13 @@ class Binder : public cSimpleModule
     // list of all UEs. Used for inter-cell interference evaluation
     std::vector<UeInfo *> ueList_;
 
+    // dense index of the UEs' information, indexed by MacNodeId (nullptr if not a registered UE)
+    std::vector<UeInfo *> ueInfoIndex_;
+
+    // for each carrier frequency, the realistic channel model of each UE, indexed by MacNodeId.
+    // Entries are resolved on first access and cleared when the UE is unregistered
+    std::map<GHz, std::vector<LteRealisticChannelModel *>> ueChannelModelIndex_;
+
     // list of all background traffic managers. Used for background UEs CQI computation
     std::vector<BgTrafficManagerInfo *> bgTrafficManagerList_;
 
@@ -105,9 +112,15 @@ class Binder : public cSimpleModule
     /*
      * Uplink interference support
      */
-    typedef std::map<GHz, std::vector<std::vector<std::vector<UeAllocationInfo>>>> UplinkTransmissionMap;
+    // transmissions of the previous and the current TTI, stored in a two-slot ring buffer so that
+    // moving to the next TTI does not move or reallocate the per-band data
+    struct UplinkTransmissionRing
+    {
+        UlTransmissionMap slots[2];
+        unsigned int curr = 0; // slot of the current TTI
+    };
     // for each carrier frequency, for both previous and current TTIs, for each RB, stores the UE (nodeId and ref to the PHY module) that transmitted/are transmitting within that RB
-    UplinkTransmissionMap ulTransmissionMap_;
+    std::map<GHz, UplinkTransmissionRing> ulTransmissionMap_;
     // TTI of the last update of the UL band status
     simtime_t lastUpdateUplinkTransmissionInfo_;
     // TTI of the last UL transmission (used for optimization purposes, see initAndResetUlTransmissionInfo() )
@@ -460,7 +473,7 @@ class Binder : public cSimpleModule
         return extCellList_[carrierFrequency].size() - 1;
     }
 
-    virtual ExtCellList getExtCellList(GHz carrierFrequency)
+    virtual const ExtCellList& getExtCellList(GHz carrierFrequency)
     {
         return extCellList_[carrierFrequency];
     }
@@ -489,16 +502,27 @@ class Binder : public cSimpleModule
         return enbList_;
     }
 
-    virtual void addUeInfo(UeInfo *info)
-    {
-        ueList_.push_back(info);
-    }
+    virtual void addUeInfo(UeInfo *info);
 
     virtual const std::vector<UeInfo *>& getUeList()
     {
         return ueList_;
     }
 
+    /**
+     * Returns the UeInfo of the given UE, or nullptr if not found
+     */
+    virtual UeInfo *getUeInfo(MacNodeId ueId)
+    {
+        return (num(ueId) < ueInfoIndex_.size()) ? ueInfoIndex_[num(ueId)] : nullptr;
+    }
+
+    /**
+     * Returns the realistic channel model used by the given UE on the given carrier,
+     * or nullptr if the UE is not found or does not use a realistic channel model on that carrier
+     */
+    virtual LteRealisticChannelModel *getUeRealisticChannelModel(MacNodeId ueId, GHz carrierFrequency);
+
     virtual void addBgTrafficManagerInfo(BgTrafficManagerInfo *info)
     {
         bgTrafficManagerList_.push_back(info);
@@ -520,7 +544,7 @@ class Binder : public cSimpleModule
     virtual void initAndResetUlTransmissionInfo();
     virtual void storeUlTransmissionMap(GHz carrierFreq, Remote antenna, RbMap& rbMap, MacNodeId nodeId, MacCellId cellId, LtePhyBase *phy, Direction dir);
     virtual void storeUlTransmissionMap(GHz carrierFreq, Remote antenna, RbMap& rbMap, MacNodeId nodeId, MacCellId cellId, TrafficGeneratorBase *trafficGen, Direction dir);  // overloaded function for bgUes
-    virtual const std::vector<std::vector<UeAllocationInfo>> *getUlTransmissionMap(GHz carrierFreq, UlTransmissionMapTTI t);
+    virtual const UlTransmissionMap *getUlTransmissionMap(GHz carrierFreq, UlTransmissionMapTTI t);
     /*
      * X2 Support
      */
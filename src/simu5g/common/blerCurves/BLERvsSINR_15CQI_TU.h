@@ -26,7 +26,7 @@
 
 namespace simu5g {
 
-static double BLER_15_CQI_TU[15][16] = {
+static constexpr double BLER_15_CQI_TU[15][16] = {
     {
         1, 1, 0.996, 0.992, 0.968, 0.88, 0.76, 0.564, 0.364, 0.22, 0.084, 0.044, 0.008, 0, 0.004, 0,
     },
@@ -75,7 +75,7 @@ static double BLER_15_CQI_TU[15][16] = {
 
 };
 
-static double SINR_15_CQI_TU[15][16] = {
+static constexpr double SINR_15_CQI_TU[15][16] = {
     {
         -14.5, -13.5, -12.5, -11.5, -10.5, -9.5, -8.5, -7.5, -6.5, -5.5, -4.5, -3.5, -2.5, -1.5, -0.5, 0.5,
     },
@@ -169,6 +169,80 @@ static double GetBLER_TU(double SINR, int MCS)
     return BLER;
 }
 
+/*
+ * BLER curves resampled on a regular SINR grid with BLER_TU_GRID_RESOLUTION points per dB.
+ * The breakpoints of every curve are 1 dB apart, so the grid contains all of them and
+ * each grid cell lies within a single segment of the piecewise-linear curve: sampling it
+ * with the same interpolation used by GetBLER_TU() and interpolating between neighbouring
+ * grid points yields the original curve without scanning the breakpoints.
+ * With a resolution of 2 points per dB, integer SINR values always fall on a grid point,
+ * hence GetBLER_TU_Grid() returns exactly the same value as GetBLER_TU() for them.
+ */
+constexpr int BLER_TU_GRID_RESOLUTION = 2;
+constexpr int BLER_TU_GRID_SIZE = 15 * BLER_TU_GRID_RESOLUTION + 1;
+
+struct BlerTuGrid
+{
+    double bler[15][BLER_TU_GRID_SIZE];
+};
+
+constexpr bool hasUniformBlerTuBreakpoints()
+{
+    for (int cqi = 0; cqi < 15; cqi++)
+        for (int i = 0; i < 15; i++)
+            if (SINR_15_CQI_TU[cqi][i + 1] - SINR_15_CQI_TU[cqi][i] != 1.0)
+                return false;
+    return true;
+}
+
+static_assert(hasUniformBlerTuBreakpoints(), "BLER curves must have breakpoints 1 dB apart to be sampled on a regular grid");
+
+constexpr BlerTuGrid buildBlerTuGrid()
+{
+    BlerTuGrid grid{};
+    for (int cqi = 0; cqi < 15; cqi++) {
+        for (int point = 0; point < BLER_TU_GRID_SIZE; point++) {
+            int index = point / BLER_TU_GRID_RESOLUTION;
+            int step = point % BLER_TU_GRID_RESOLUTION;
+            if (step == 0) {
+                grid.bler[cqi][point] = BLER_15_CQI_TU[cqi][index];
+            }
+            else {
+                // same interpolation as GetBLER_TU()
+                double SINR = SINR_15_CQI_TU[cqi][index] + (double)step / BLER_TU_GRID_RESOLUTION;
+                double R = (SINR - SINR_15_CQI_TU[cqi][index]) / (SINR_15_CQI_TU[cqi][index + 1] - SINR_15_CQI_TU[cqi][index]);
+                grid.bler[cqi][point] = BLER_15_CQI_TU[cqi][index] + R * (BLER_15_CQI_TU[cqi][index + 1] - BLER_15_CQI_TU[cqi][index]);
+            }
+        }
+    }
+    return grid;
+}
+
+static constexpr BlerTuGrid BLER_TU_GRID = buildBlerTuGrid();
+
+/*
+ * O(1) version of GetBLER_TU(), based on BLER_TU_GRID
+ *
+ * @param SINR the SINR in dB
+ * @param MCS the CQI of the curve, in the range [1,15]
+ */
+inline double GetBLER_TU_Grid(double SINR, int MCS)
+{
+    const double *sinrCurve = SINR_15_CQI_TU[MCS - 1];
+    if (SINR <= sinrCurve[0])
+        return 1.0;
+    if (SINR >= sinrCurve[15])
+        return 0.0;
+
+    const double *blerCurve = BLER_TU_GRID.bler[MCS - 1];
+    double position = (SINR - sinrCurve[0]) * BLER_TU_GRID_RESOLUTION;
+    int point = (int)position;
+    double R = position - point;
+    if (R == 0.0)
+        return blerCurve[point];
+    return blerCurve[point] + R * (blerCurve[point + 1] - blerCurve[point]);
+}
+
 } //namespace
 
 #endif /* BLERVSSINR_15CQI_TU_H_ */
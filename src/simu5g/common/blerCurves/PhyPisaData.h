@@ -42,7 +42,8 @@ class PhyPisaData
 
     // getBler gets the following parameters: (txMode , CQI, SINR)
     //double getBler(int i, int j, int k){if (j==0) return 1; else return blerCurves_[i][j][k-1+blerShift_];}
-    double getBler(int i, int j, int k) { return GetBLER_TU(k + blerShift_, j); };
+    // curves outside the range [1,15] keep going through the original (scanning) implementation
+    double getBler(int i, int j, int k) { return (j >= 1 && j <= 15) ? GetBLER_TU_Grid(k + blerShift_, j) : GetBLER_TU(k + blerShift_, j); };
     int minSnr() { return -14 - blerShift_; }//SINR_15_CQI_TU [0] [0];}
     int maxSnr() { return 40 - blerShift_; }//SINR_15_CQI_TU [14] [15];}
 
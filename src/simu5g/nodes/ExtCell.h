@@ -112,6 +112,11 @@ class ExtCell : public cSimpleModule
 
     int getPrevBandStatus(int band) { return prevBandStatus_.at(band); }
 
+    // Band occupation status of all the bands (1 if the band is allocated, 0 otherwise)
+    const BandStatus& getBandStatus() const { return bandStatus_; }
+
+    const BandStatus& getPrevBandStatus() const { return prevBandStatus_; }
+
     // Set the band utilization percentage
     void setBandUtilization(double bandUtilization);
 };
@@ -397,10 +397,19 @@ void LteMacBase::handleMessage(cMessage *msg)
 {
     if (msg->isSelfMessage()) {
         handleSelfMessage();
+        if (eventDrivenTti_ && isIdle()) {
+            // suspend the TTI tick until the next message from RLC or PHY
+            EV << NOW << " LteMacBase::handleMessage - node " << nodeId_ << " is idle, TTI tick suspended" << endl;
+            lastTtiTick_ = NOW;
+            return;
+        }
         scheduleAt(NOW + ttiPeriod_, ttiTick_);
         return;
     }
 
+    if (eventDrivenTti_ && !ttiTick_->isScheduled())
+        wakeUp(msg);
+
     cPacket *pkt = check_and_cast<cPacket *>(msg);
     EV << "LteMacBase : Received packet " << pkt->getName() <<
         " from port " << pkt->getArrivalGate()->getName() << endl;
@@ -421,6 +430,27 @@ void LteMacBase::handleMessage(cMessage *msg)
     }
 }
 
+void LteMacBase::wakeUp(cMessage *msg)
+{
+    // ticks would have been scheduled at lastTtiTick_ + k * period, k > 0
+    simtime_t period = ttiPeriod_;
+    int64_t elapsed = (NOW - lastTtiTick_).raw();
+    int64_t nextTick = elapsed / period.raw() + 1;
+
+    // a tick at the current time is still to be handled if it comes after this message. With equal
+    // priorities, the tick would have been inserted first, hence it would have been handled already
+    if (nextTick > 1 && elapsed % period.raw() == 0 && msg->getSchedulingPriority() < ttiTick_->getSchedulingPriority())
+        nextTick--;
+
+    EV << NOW << " LteMacBase::wakeUp - node " << nodeId_ << " skipped " << nextTick - 1 << " idle TTIs" << endl;
+
+    if (nextTick > 1) {
+        skipIdleTtis(nextTick - 1);
+        numSkippedTtis_ += nextTick - 1;
+    }
+    scheduleAt(SimTime::fromRaw(lastTtiTick_.raw() + period.raw() * nextTick), ttiTick_);
+}
+
 void LteMacBase::insertMacPdu(const inet::Packet *macPdu)
 {
     auto lteInfo = macPdu->getTag<UserControlInfo>();
@@ -459,6 +489,7 @@ void LteMacBase::discardRlcPdu(inet::Ptr<const UserControlInfo> lteInfo, unsigne
 
 void LteMacBase::deleteModule() {
     cancelAndDelete(ttiTick_);
+    cancelAndDelete(flushHarqMsg_);
     cSimpleModule::deleteModule();
 }
 
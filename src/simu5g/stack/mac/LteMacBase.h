@@ -99,9 +99,24 @@ class LteMacBase : public cSimpleModule
     /// TTI self message
     cMessage *ttiTick_ = nullptr;
 
+    /// self message that triggers flushing of the H-ARQ TX buffers at the end of the TTI (rescheduled at every TTI)
+    cMessage *flushHarqMsg_ = nullptr;
+
     /// TTI for this node
     double ttiPeriod_ = TTI;
 
+    /*
+     * Event-driven TTI mode: the TTI tick is not rescheduled while the node is idle
+     * (see isIdle()), and it is rescheduled on the next message from RLC or PHY
+     */
+    bool eventDrivenTti_ = false;
+
+    /// time of the last handled TTI tick (event-driven TTI mode)
+    simtime_t lastTtiTick_;
+
+    /// number of TTIs that were not handled because the node was idle (event-driven TTI mode)
+    unsigned long numSkippedTtis_ = 0;
+
     /// MacNodeId
     MacNodeId nodeId_ = NODEID_NONE;
 
@@ -389,6 +404,30 @@ class LteMacBase : public cSimpleModule
      */
     virtual void handleSelfMessage() = 0;
 
+    /**
+     * Event-driven TTI mode: returns true if handling the next TTIs would
+     * not change the state of this node, apart from what skipIdleTtis()
+     * reproduces, so that the TTI tick can be suspended
+     */
+    virtual bool isIdle()
+    {
+        return false;
+    }
+
+    /**
+     * Event-driven TTI mode: applies the effect of the given number of
+     * TTIs that have not been handled while the node was idle
+     */
+    virtual void skipIdleTtis(unsigned int numTtis) {}
+
+    /**
+     * Event-driven TTI mode: reschedules the TTI tick at the first TTI
+     * that has not elapsed yet, after skipping the TTIs elapsed while idle
+     *
+     * @param msg message that woke up the node
+     */
+    void wakeUp(cMessage *msg);
+
     /**
      * sendLowerPackets() is used
      * to send packets to lower layer
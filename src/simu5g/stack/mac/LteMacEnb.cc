@@ -139,6 +139,7 @@ void LteMacEnb::initialize(int stage)
         cellInfo_.reference(this, "cellInfoModule", true);
 
         eNodeBCount = par("eNodeBCount");
+        checkIdleTtiAllocations_ = par("checkIdleTtiAllocations");
         WATCH_MAP(bsrbuf_);
     }
     else if (stage == INITSTAGE_SIMU5G_REGISTRATIONS) {
@@ -207,6 +208,8 @@ void LteMacEnb::initialize(int stage)
         // the period is equal to the minimum period according to the numerologies used by the carriers in this node
         ttiTick_ = new cMessage("ttiTick_");
         ttiTick_->setSchedulingPriority(1);                                              // TTI TICK after other messages
+        flushHarqMsg_ = new cMessage("flushHarqMsg");
+        flushHarqMsg_->setSchedulingPriority(1);                                         // after other messages
         ttiPeriod_ = binder_->getSlotDurationFromNumerologyIndex(cellInfo_->getMaxNumerologyIndex());
         scheduleAt(NOW + ttiPeriod_, ttiTick_);
 
@@ -228,9 +231,8 @@ void LteMacEnb::initialize(int stage)
 void LteMacEnb::handleMessage(cMessage *msg)
 {
     if (msg->isSelfMessage()) {
-        if (strcmp(msg->getName(), "flushHarqMsg") == 0) {
+        if (msg == flushHarqMsg_) {
             flushHarqBuffers();
-            delete msg;
             return;
         }
     }
@@ -797,6 +799,14 @@ void LteMacEnb::handleSelfMessage()
 
     EV << "-----" << "ENB MAIN LOOP -----" << endl;
 
+    // in a cell without traffic, the periodic events must reuse their messages
+    if (checkIdleTtiAllocations_) {
+        uint64_t messageCount = cMessage::getTotalMessageCount();
+        if (lastTtiMessageCount_ != 0 && messageCount != lastTtiMessageCount_)
+            throw cRuntimeError("LteMacEnb::handleSelfMessage - %d messages created during an idle TTI", (int)(messageCount - lastTtiMessageCount_));
+        lastTtiMessageCount_ = messageCount;
+    }
+
     // Resolve any RAC requests buffered since the last TTI (preamble collision detection)
     resolveRacCollisions();
 
@@ -863,9 +873,7 @@ void LteMacEnb::handleSelfMessage()
 
     // Message that triggers flushing of TX HARQ buffers for all users
     // This way, flushing is performed after the (possible) reception of new MAC PDUs
-    cMessage *flushHarqMsg = new cMessage("flushHarqMsg");
-    flushHarqMsg->setSchedulingPriority(1);        // after other messages
-    scheduleAt(NOW, flushHarqMsg);
+    scheduleAt(NOW, flushHarqMsg_);
 
     decreaseNumerologyPeriodCounter();
 
@@ -934,6 +942,10 @@ void LteMacEnb::macHandleFeedbackPkt(cPacket *pktAux)
                 amc_->pushFeedback(srcNodeId, UL, fb, lteInfo->getCarrierFrequency());
         }
     }
+
+    // let the scheduling modules that cache the transmission parameters refresh them
+    enbSchedulerDl_->txParamsChanged(srcNodeId);
+    enbSchedulerUl_->txParamsChanged(srcNodeId);
     delete pkt;
 }
 
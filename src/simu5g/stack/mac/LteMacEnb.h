@@ -73,6 +73,11 @@ class LteMacEnb : public LteMacBase
     std::map<GHz, int> needRtxUl_;
     std::map<GHz, int> needRtxD2D_;
 
+    /// If true, an error is raised if any message is created between two TTIs (for testing, in a simulation without traffic)
+    bool checkIdleTtiAllocations_ = false;
+    /// Number of messages created so far, as of the previous TTI (see checkIdleTtiAllocations_)
+    uint64_t lastTtiMessageCount_ = 0;
+
     /**
      * Reads MAC parameters for eNb and performs initialization.
      */
@@ -12,6 +12,8 @@
 
 #include "simu5g/stack/mac/LteMacUe.h"
 
+#include <algorithm>
+
 #include <inet/networklayer/ipv4/Ipv4InterfaceData.h>
 
 #include "simu5g/corenetwork/statsCollector/UeStatsCollector.h"
@@ -66,6 +68,9 @@ void LteMacUe::initialize(int stage)
         maxRacBackoff_ = par("racBackoffMax");
         raRespWinStart_ = par("raResponseWindow");
         bsrRtxTimerStart_ = par("retxBsrTimer");
+
+        eventDrivenTti_ = par("eventDrivenTti");
+        WATCH(numSkippedTtis_);
     }
     else if (stage == INITSTAGE_SIMU5G_MAC_SCHEDULER_CREATION) {
         cellId_ = binder_->getServingNode(nodeId_);
@@ -148,6 +153,9 @@ void LteMacUe::initialize(int stage)
         ttiTick_ = new cMessage("ttiTick_");
         ttiTick_->setSchedulingPriority(1);    // TTI TICK after other messages
 
+        flushHarqMsg_ = new cMessage("flushHarqMsg");
+        flushHarqMsg_->setSchedulingPriority(1);    // after other messages
+
         if (!isNrUe(nodeId_)) {
             // if this MAC layer refers to the LTE side of the UE, then the TTI is equal to 1ms
             ttiPeriod_ = TTI;
@@ -175,9 +183,8 @@ void LteMacUe::initialize(int stage)
 void LteMacUe::handleMessage(cMessage *msg)
 {
     if (msg->isSelfMessage()) {
-        if (strcmp(msg->getName(), "flushHarqMsg") == 0) {
+        if (msg == flushHarqMsg_) {
             flushHarqBuffers();
-            delete msg;
             return;
         }
     }
@@ -727,9 +734,7 @@ void LteMacUe::handleSelfMessage()
 
         // Message that triggers flushing of Tx H-ARQ buffers for all users
         // This way, flushing is performed after the (possible) reception of new MAC PDUs
-        cMessage *flushHarqMsg = new cMessage("flushHarqMsg");
-        flushHarqMsg->setSchedulingPriority(1);        // after other messages
-        scheduleAt(NOW, flushHarqMsg);
+        scheduleAt(NOW, flushHarqMsg_);
     }
 
     //============================ DEBUG ==========================
@@ -897,6 +902,45 @@ void LteMacUe::checkRAC()
     }
 }
 
+bool LteMacUe::isIdle()
+{
+    if (racRequested_ || requestedSdus_ > 0)
+        return false;
+
+    for (const auto& [carrierFreq, grant] : schedulingGrant_) {
+        if (grant != nullptr)
+            return false;
+    }
+
+    for (const auto& [cid, connInfo] : connDescOut_) {
+        if (!connInfo.buffer->isEmpty() || !connInfo.queue->isEmpty())
+            return false;
+    }
+
+    // received PDUs need a TTI to be evaluated and extracted
+    for (const auto& [carrierFreq, harqRxMap] : harqRxBuffers_) {
+        for (const auto& [nodeId, rxBuffer] : harqRxMap) {
+            if (rxBuffer->isHarqBufferActive())
+                return false;
+        }
+    }
+    return true;
+}
+
+void LteMacUe::skipIdleTtis(unsigned int numTtis)
+{
+    // an idle TTI only calls checkRAC(), which decreases one timer at a time
+    unsigned int remaining = numTtis;
+    for (unsigned int *timer : {&racBackoffTimer_, &raRespTimer_, &bsrRtxTimer_}) {
+        unsigned int elapsed = std::min(*timer, remaining);
+        *timer -= elapsed;
+        remaining -= elapsed;
+    }
+
+    // ...and increments the current H-ARQ process
+    currentHarq_ = (currentHarq_ + numTtis) % harqProcesses_;
+}
+
 void LteMacUe::updateUserTxParam(cPacket *pktAux)
 {
     auto pkt = check_and_cast<inet::Packet *>(pktAux);
@@ -151,6 +151,20 @@ class LteMacUe : public LteMacBase
      */
     virtual void flushHarqBuffers();
 
+    /*
+     * Event-driven TTI mode: the UE is idle when it has no configured grants,
+     * no pending data or MAC SDU requests, no active H-ARQ RX processes and no
+     * pending RAC request. RAC and BSR timers are allowed to run, since they are
+     * advanced by skipIdleTtis()
+     */
+    bool isIdle() override;
+
+    /*
+     * Event-driven TTI mode: advances the RAC and BSR timers and the
+     * H-ARQ process counter as the skipped TTIs would have done
+     */
+    void skipIdleTtis(unsigned int numTtis) override;
+
   public:
     LteMacUe();
     ~LteMacUe() override;
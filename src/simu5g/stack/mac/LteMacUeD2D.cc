@@ -416,6 +416,9 @@ void LteMacUeD2D::handleMessage(cMessage *msg)
             // message from PHY_to_MAC gate (from the lower layer)
             emit(receivedPacketFromLowerLayerSignal_, pkt);
 
+            if (eventDrivenTti_ && !ttiTick_->isScheduled())
+                wakeUp(pkt);
+
             // call handler
             macHandleD2DModeSwitch(pkt);
 
@@ -460,6 +463,11 @@ void LteMacUeD2D::macHandleGrant(cPacket *pktAux)
     delete pkt;
 }
 
+bool LteMacUeD2D::isIdle()
+{
+    return !racD2DMulticastRequested_ && LteMacUe::isIdle();
+}
+
 void LteMacUeD2D::checkRAC()
 {
     EV << NOW << " LteMacUeD2D::checkRAC , Ue  " << nodeId_ << ", racTimer : " << racBackoffTimer_ << " maxRacTryOuts : " << maxRacTryouts_
@@ -724,9 +732,7 @@ void LteMacUeD2D::handleSelfMessage()
 
         // Message that triggers flushing of Tx H-ARQ buffers for all users
         // This way, flushing is performed after the (possible) reception of new MAC PDUs
-        cMessage *flushHarqMsg = new cMessage("flushHarqMsg");
-        flushHarqMsg->setSchedulingPriority(1);        // after other messages
-        scheduleAt(NOW, flushHarqMsg);
+        scheduleAt(NOW, flushHarqMsg_);
     }
 
     //============================ DEBUG ==========================
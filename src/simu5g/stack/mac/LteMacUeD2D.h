@@ -71,6 +71,11 @@ class LteMacUeD2D : public LteMacUe
      */
     void checkRAC() override;
 
+    /*
+     * Event-driven TTI mode: also requires no pending D2D multicast RAC request
+     */
+    bool isIdle() override;
+
     /*
      * Receives and handles RAC responses
      */
@@ -190,9 +190,7 @@ void NrMacUe::handleSelfMessage()
 
         // Message that triggers flushing of Tx H-ARQ buffers for all users
         // This way, flushing is performed after the (possible) reception of new MAC PDUs
-        cMessage *flushHarqMsg = new cMessage("flushHarqMsg");
-        flushHarqMsg->setSchedulingPriority(1);        // after other messages
-        scheduleAt(NOW, flushHarqMsg);
+        scheduleAt(NOW, flushHarqMsg_);
     }
 
     //============================ DEBUG ==========================
@@ -226,6 +224,15 @@ void NrMacUe::handleSelfMessage()
     EV << "--- END UE MAIN LOOP ---" << endl;
 }
 
+void NrMacUe::skipIdleTtis(unsigned int numTtis)
+{
+    LteMacUeD2D::skipIdleTtis(numTtis);
+
+    // same as calling decreaseNumerologyPeriodCounter() once per TTI
+    for (auto& [index, counter] : numerologyPeriodCounter_)
+        counter.current = (counter.current + counter.max - numTtis % counter.max) % counter.max;
+}
+
 int NrMacUe::macSduRequest()
 {
     EV << "----- START NrMacUe::macSduRequest -----\n";
@@ -45,6 +45,11 @@ class NrMacUe : public LteMacUeD2D
      * containing the size of its buffer (for that CID)
      */
     void macPduMake(MacCid cid = MacCid()) override;
+
+    /*
+     * Event-driven TTI mode: also advances the numerology period counters
+     */
+    void skipIdleTtis(unsigned int numTtis) override;
 };
 
 } //namespace
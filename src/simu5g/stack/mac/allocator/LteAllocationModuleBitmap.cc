@@ -0,0 +1,263 @@
+//
+//                  Simu5G
+//
+// Copyright (C) 2022-2026 Giovanni Nardini, Giovanni Stea et al. (University of Pisa)
+//
+// This file is part of a software released under the license included in file
+// "license.pdf". Please read LICENSE and README files before using it.
+// The above files and the present reference are part of the software itself,
+// and cannot be removed from it.
+//
+
+#include "simu5g/stack/mac/allocator/LteAllocationModuleBitmap.h"
+#include "simu5g/stack/mac/LteMacEnb.h"
+
+namespace simu5g {
+
+using namespace omnetpp;
+
+LteAllocationModuleBitmap::LteAllocationModuleBitmap(LteMacEnb *mac, const Direction direction)
+    : LteAllocationModule(mac, direction)
+{
+}
+
+void LteAllocationModuleBitmap::init(const unsigned int resourceBlocks, const unsigned int bands)
+{
+    // same as the base class: blocks allocated before the first init are not available for interference computation
+    hasPrevBandBlocks_ = !bandBlocks_.empty();
+    prevBandBlocks_ = bandBlocks_;
+
+    LteAllocationModule::init(resourceBlocks, bands);
+
+    unsigned int size = numAntennas_ * bands_;
+    unsigned int words = (size + 63) / 64;
+
+    bandBlocks_.assign(size, 0);
+    prevBandBlocks_.resize(size, 0);
+    bandUes_.assign(size, std::vector<BandUeAllocation>());
+    occupiedBands_.assign(words, 0);
+    usedBands_.assign(words, 0);
+
+    std::fill(ueBlocks_.begin(), ueBlocks_.end(), 0);
+    std::fill(ueBytes_.begin(), ueBytes_.end(), 0);
+    usedUes_.clear();
+}
+
+void LteAllocationModuleBitmap::reset(const unsigned int resourceBlocks, const unsigned int bands)
+{
+    // copy stored block-allocation info
+    prevBandBlocks_ = bandBlocks_;
+    hasPrevBandBlocks_ = true;
+
+    // reset structures only if they were used in the previous time slot
+    if (usedInLastSlot_) {
+        for (auto& plane : totalRbsMatrix_)
+            std::fill(plane.begin(), plane.end(), resourceBlocks);
+        for (auto& plane : allocatedRbsMatrix_)
+            std::fill(plane.begin(), plane.end(), 0);
+
+        std::fill(bandBlocks_.begin(), bandBlocks_.end(), 0);
+        std::fill(occupiedBands_.begin(), occupiedBands_.end(), 0);
+
+        // clear the per-band UE lists that have been used, keeping their capacity
+        for (unsigned int w = 0; w < usedBands_.size(); ++w) {
+            uint64_t word = usedBands_[w];
+            for (unsigned int bit = 0; word != 0; ++bit, word >>= 1) {
+                if (word & 1)
+                    bandUes_[w * 64 + bit].clear();
+            }
+            usedBands_[w] = 0;
+        }
+
+        for (MacNodeId nodeId : usedUes_) {
+            ueBlocks_[num(nodeId)] = 0;
+            ueBytes_[num(nodeId)] = 0;
+        }
+        usedUes_.clear();
+    }
+
+    usedInLastSlot_ = false;
+}
+
+LteAllocationModuleBitmap::BandUeAllocation *LteAllocationModuleBitmap::findBandUe(unsigned int i, const MacNodeId nodeId)
+{
+    for (auto& alloc : bandUes_[i]) {
+        if (alloc.nodeId == nodeId)
+            return &alloc;
+    }
+    return nullptr;
+}
+
+unsigned int LteAllocationModuleBitmap::ueIndex(const MacNodeId nodeId)
+{
+    unsigned int i = num(nodeId);
+    if (i >= ueBlocks_.size()) {
+        ueBlocks_.resize(i + 1, 0);
+        ueBytes_.resize(i + 1, 0);
+    }
+    return i;
+}
+
+unsigned int LteAllocationModuleBitmap::availableBlocks(const MacNodeId nodeId, const Remote antenna, const Band band)
+{
+    if (antenna != MACRO)
+        throw cRuntimeError("LteAllocator::availableBlocks(): antenna %s not supported by the bitmap allocator", dasToA(antenna).c_str());
+
+    // one block per band, available if nothing has been allocated in the band yet
+    if (band >= bands_ || isOccupied(index(antenna, band)))
+        return 0;
+
+    EV << NOW << " LteAllocator::availableBlocks " << dirToA(dir_) << " - Band " << band << " has 1 block available" << endl;
+    return 1;
+}
+
+unsigned int LteAllocationModuleBitmap::availableBlocks(const MacNodeId nodeId, const Plane plane, const Band band)
+{
+    return availableBlocks(nodeId, MACRO, band);
+}
+
+bool LteAllocationModuleBitmap::addBlocks(const Band band, const MacNodeId nodeId, const unsigned int blocks, const unsigned int bytes)
+{
+    return addBlocks(MACRO, band, nodeId, blocks, bytes);
+}
+
+bool LteAllocationModuleBitmap::addBlocks(const Remote antenna, const Band band, const MacNodeId nodeId,
+        const unsigned int blocks, const unsigned int bytes)
+{
+    if (antenna != MACRO)
+        throw cRuntimeError("LteAllocator::addBlocks(): antenna %s not supported by the bitmap allocator", dasToA(antenna).c_str());
+
+    // Check if the band exists
+    if (band >= bands_)
+        throw cRuntimeError("LteAllocator::addBlocks(): Invalid band %d", (int)band);
+
+    unsigned int i = index(antenna, band);
+
+    // Check if the band can satisfy the request
+    if (isOccupied(i)) {
+        EV << NOW << " LteAllocator::addBlocks " << dirToA(dir_) << " - Node " << nodeId <<
+            ", not enough space on band " << band << ": requested " << blocks << " available 0 " << endl;
+        return false;
+    }
+    // check if UE is out of range. (CQI=0 => bytes=0)
+    if (bytes == 0) {
+        EV << NOW << " LteAllocator::addBlocks " << dirToA(dir_) << " - Node " << nodeId << " - 0 bytes available with " << blocks << " blocks" << endl;
+        return false;
+    }
+
+    // Note the request on the per-band structures
+    BandUeAllocation *alloc = findBandUe(i, nodeId);
+    if (alloc == nullptr) {
+        bandUes_[i].push_back({nodeId, 0, 0});
+        usedBands_[i / 64] |= (uint64_t)1 << (i % 64);
+        alloc = &bandUes_[i].back();
+    }
+    alloc->blocks += blocks;
+    alloc->bytes += bytes;
+    bandBlocks_[i] += blocks;
+    setOccupied(i, bandBlocks_[i] > 0);
+
+    // ...and on the per-UE counters
+    unsigned int u = ueIndex(nodeId);
+    if (ueBlocks_[u] == 0 && ueBytes_[u] == 0)
+        usedUes_.push_back(nodeId);
+    ueBlocks_[u] += blocks;
+    ueBytes_[u] += bytes;
+
+    // update the allocatedBlocks counter
+    allocatedRbsMatrix_[MAIN_PLANE][antenna] += blocks;
+
+    usedInLastSlot_ = true;
+
+    EV << NOW << " LteAllocator::addBlocks " << dirToA(dir_) << " - Node " << nodeId << ", the request of " << blocks << " blocks on band " << band << " satisfied" << endl;
+
+    return true;
+}
+
+unsigned int LteAllocationModuleBitmap::removeBlocks(const Remote antenna, const Band band, const MacNodeId nodeId)
+{
+    if (antenna != MACRO)
+        throw cRuntimeError("LteAllocator::removeBlocks(): antenna %s not supported by the bitmap allocator", dasToA(antenna).c_str());
+
+    // Check if the band exists
+    if (band >= bands_) {
+        EV << NOW << " LteAllocator::removeBlocks " << dirToA(dir_) << " - Node " << nodeId << ", invalid band " << band << endl;
+        return 0;
+    }
+
+    unsigned int i = index(antenna, band);
+    BandUeAllocation *alloc = findBandUe(i, nodeId);
+
+    // If the number of blocks allocated by the nodeId in the band is zero, do nothing!
+    if (alloc == nullptr || alloc->blocks == 0)
+        return 0;
+
+    unsigned int toDrain = alloc->blocks;
+
+    // Note the removal in the allocator structures. As in the base class, the bytes of the band
+    // are kept, while the bytes allocated to the UE are reset
+    alloc->blocks = 0;
+    bandBlocks_[i] -= toDrain;
+    setOccupied(i, bandBlocks_[i] > 0);
+
+    unsigned int u = ueIndex(nodeId);
+    ueBlocks_[u] -= toDrain;
+    ueBytes_[u] = 0;
+
+    // Update the allocatedBlocks counter
+    allocatedRbsMatrix_[MAIN_PLANE][antenna] -= toDrain;
+
+    usedInLastSlot_ = true;
+
+    // DEBUG
+    EV << NOW << " LteAllocator::removeBlocks " << dirToA(dir_) << " - Node " << nodeId << ", " << toDrain << " blocks drained from band " << band << endl;
+
+    return toDrain;
+}
+
+unsigned int LteAllocationModuleBitmap::getBlocks(const Remote antenna, const Band band, const MacNodeId nodeId)
+{
+    // nothing is allocated on the other antennas
+    if (antenna != MACRO || band >= bands_)
+        return 0;
+
+    BandUeAllocation *alloc = findBandUe(index(antenna, band), nodeId);
+    return (alloc == nullptr) ? 0 : alloc->blocks;
+}
+
+unsigned int LteAllocationModuleBitmap::getBlocks(const MacNodeId nodeId)
+{
+    unsigned int u = num(nodeId);
+    return (u < ueBlocks_.size()) ? ueBlocks_[u] : 0;
+}
+
+unsigned int LteAllocationModuleBitmap::getAllocatedBlocks(Plane plane, const Remote antenna, const Band band)
+{
+    return (antenna == MACRO && band < bands_) ? bandBlocks_[index(antenna, band)] : 0;
+}
+
+unsigned int LteAllocationModuleBitmap::getInterferingBlocks(Plane plane, const Remote antenna, const Band band)
+{
+    if (!hasPrevBandBlocks_)
+        return 1000;
+    return (antenna == MACRO && band < bands_) ? prevBandBlocks_[index(antenna, band)] : 0;
+}
+
+unsigned int LteAllocationModuleBitmap::getBytes(const Remote antenna, const Band band, const MacNodeId nodeId)
+{
+    if (antenna != MACRO || band >= bands_)
+        return 0;
+
+    BandUeAllocation *alloc = findBandUe(index(antenna, band), nodeId);
+    return (alloc == nullptr) ? 0 : alloc->bytes;
+}
+
+unsigned int LteAllocationModuleBitmap::rbOccupation(const MacNodeId nodeId, RbMap& rbMap)
+{
+    unsigned int blocks = 0;
+    for (Band b = 0; b < bands_; ++b)
+        blocks += (rbMap[MACRO][b] = getBlocks(MACRO, b, nodeId));
+    return blocks;
+}
+
+} //namespace
@@ -0,0 +1,116 @@
+//
+//                  Simu5G
+//
+// Copyright (C) 2022-2026 Giovanni Nardini, Giovanni Stea et al. (University of Pisa)
+//
+// This file is part of a software released under the license included in file
+// "license.pdf". Please read LICENSE and README files before using it.
+// The above files and the present reference are part of the software itself,
+// and cannot be removed from it.
+//
+
+#ifndef _LTE_LTEALLOCATIONMODULEBITMAP_H_
+#define _LTE_LTEALLOCATIONMODULEBITMAP_H_
+
+#include "simu5g/common/LteCommon.h"
+#include "simu5g/stack/mac/allocator/LteAllocationModule.h"
+
+namespace simu5g {
+
+/*
+ * Allocation module with the same behavior as LteAllocationModule, where the per-band
+ * and per-UE maps are replaced by flat arrays indexed by [antenna][band], a bitmap of the
+ * occupied bands and per-UE counters indexed by node ID.
+ * The structures are allocated once in init() and cleared in place at every slot, so
+ * that queries and updates do not allocate memory nor perform map lookups.
+ *
+ * Only the main plane is supported. The per-UE allocation lists and the per-UE map of
+ * the base class (getAllocatedBlocksUe*() iterators) are not maintained.
+ */
+class LteAllocationModuleBitmap : public LteAllocationModule
+{
+  protected:
+    // blocks and bytes allocated to a UE in a band
+    struct BandUeAllocation
+    {
+        MacNodeId nodeId;
+        unsigned int blocks;
+        unsigned int bytes;
+    };
+
+    // number of antennas (only MACRO is currently supported)
+    static const unsigned int numAntennas_ = MACRO + 1;
+
+    // allocated blocks, for each [antenna][band], in the current and in the previous slot
+    std::vector<unsigned int> bandBlocks_;
+    std::vector<unsigned int> prevBandBlocks_;
+    bool hasPrevBandBlocks_ = false;
+
+    // UEs allocated in each [antenna][band]. At most one UE, unless zero blocks are allocated
+    std::vector<std::vector<BandUeAllocation>> bandUes_;
+
+    // bit set for each [antenna][band] with allocated blocks
+    std::vector<uint64_t> occupiedBands_;
+
+    // bit set for each [antenna][band] with a non-empty entry in bandUes_
+    std::vector<uint64_t> usedBands_;
+
+    // blocks and bytes allocated to each UE, indexed by node ID
+    std::vector<unsigned int> ueBlocks_;
+    std::vector<unsigned int> ueBytes_;
+    std::vector<MacNodeId> usedUes_;
+
+    unsigned int index(const Remote antenna, const Band band) const
+    {
+        return antenna * bands_ + band;
+    }
+
+    bool isOccupied(unsigned int i) const
+    {
+        return occupiedBands_[i / 64] & ((uint64_t)1 << (i % 64));
+    }
+
+    void setOccupied(unsigned int i, bool occupied)
+    {
+        if (occupied)
+            occupiedBands_[i / 64] |= (uint64_t)1 << (i % 64);
+        else
+            occupiedBands_[i / 64] &= ~((uint64_t)1 << (i % 64));
+    }
+
+    // returns the allocation of the given UE in the given [antenna][band], or nullptr
+    BandUeAllocation *findBandUe(unsigned int i, const MacNodeId nodeId);
+
+    // returns the index of the per-UE counters for the given UE, resizing them if needed
+    unsigned int ueIndex(const MacNodeId nodeId);
+
+  public:
+    LteAllocationModuleBitmap(LteMacEnb *mac, const Direction direction);
+
+    void init(const unsigned int resourceBlocks, const unsigned int bands) override;
+    void reset(const unsigned int resourceBlocks, const unsigned int bands) override;
+
+    unsigned int availableBlocks(const MacNodeId nodeId, const Plane plane, const Band band) override;
+    unsigned int availableBlocks(const MacNodeId nodeId, const Remote antenna, const Band band) override;
+
+    bool addBlocks(const Remote antenna, const Band band, const MacNodeId nodeId, const unsigned int blocks,
+            const unsigned int bytes) override;
+    bool addBlocks(const Band band, const MacNodeId nodeId, const unsigned int blocks, const unsigned int bytes) override;
+
+    unsigned int removeBlocks(const Remote antenna, const Band band, const MacNodeId nodeId) override;
+
+    using LteAllocationModule::getBlocks;
+    unsigned int getBlocks(const Remote antenna, const Band band, const MacNodeId nodeId) override;
+    unsigned int getBlocks(const MacNodeId nodeId) override;
+
+    unsigned int getAllocatedBlocks(Plane plane, const Remote antenna, const Band band) override;
+    unsigned int getInterferingBlocks(Plane plane, const Remote antenna, const Band band) override;
+
+    unsigned int getBytes(const Remote antenna, const Band band, const MacNodeId nodeId) override;
+
+    unsigned int rbOccupation(const MacNodeId nodeId, RbMap& rbMap) override;
+};
+
+} //namespace
+
+#endif
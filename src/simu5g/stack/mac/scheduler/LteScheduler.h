@@ -204,6 +204,21 @@ class LteScheduler
     {
     }
 
+    /// Called when new feedback changes the transmission parameters of the given node
+    virtual void notifyTxParamsChange(MacNodeId nodeId)
+    {
+    }
+
+    /// Called when the given node leaves the cell, after its connections have been removed from the active set
+    virtual void notifyNodeRemoval(MacNodeId nodeId)
+    {
+    }
+
+    /// Raises an error if the internal structures of the scheduling module are inconsistent
+    virtual void checkConsistency()
+    {
+    }
+
     virtual void updateSchedulingInfo()
     {
     }
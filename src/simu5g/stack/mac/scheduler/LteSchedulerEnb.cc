@@ -11,12 +11,17 @@
 //
 
 #include "simu5g/stack/mac/scheduler/LteSchedulerEnb.h"
+
+#include <climits>
+
 #include "simu5g/stack/mac/allocator/LteAllocationModule.h"
+#include "simu5g/stack/mac/allocator/LteAllocationModuleBitmap.h"
 #include "simu5g/stack/mac/allocator/LteAllocationModuleFrequencyReuse.h"
 #include "simu5g/stack/mac/scheduler/LteScheduler.h"
 #include "simu5g/stack/mac/scheduling_modules/LteDrr.h"
 #include "simu5g/stack/mac/scheduling_modules/LteMaxCi.h"
 #include "simu5g/stack/mac/scheduling_modules/LtePf.h"
+#include "simu5g/stack/mac/scheduling_modules/LtePfIncremental.h"
 #include "simu5g/stack/mac/scheduling_modules/LteMaxCiMultiband.h"
 #include "simu5g/stack/mac/scheduling_modules/LteMaxCiOptMB.h"
 #include "simu5g/stack/mac/scheduling_modules/LteMaxCiComp.h"
@@ -52,6 +57,7 @@ LteSchedulerEnb& LteSchedulerEnb::operator=(const LteSchedulerEnb& other)
     harqTxBuffers_ = other.harqTxBuffers_;
     harqRxBuffers_ = other.harqRxBuffers_;
     resourceBlocks_ = other.resourceBlocks_;
+    checkSchedulerConsistency_ = other.checkSchedulerConsistency_;
 
     emptyBandLim_ = other.emptyBandLim_;
 
@@ -72,6 +78,8 @@ LteSchedulerEnb& LteSchedulerEnb::operator=(const LteSchedulerEnb& other)
     // Copy Allocator
     if (discipline == ALLOCATOR_BESTFIT)                                            // NOTE: create this type of allocator for every scheduler using Frequency Reuse
         allocator_ = new LteAllocationModuleFrequencyReuse(mac_, direction_);
+    else if (mac_->par("bitmapAllocator").boolValue())
+        allocator_ = new LteAllocationModuleBitmap(mac_, direction_);
     else
         allocator_ = new LteAllocationModule(mac_, direction_);
 
@@ -95,6 +103,8 @@ void LteSchedulerEnb::initialize(Direction dir, LteMacEnb *mac, Binder *binder)
     harqTxBuffers_ = mac_->getHarqTxBuffers();
     harqRxBuffers_ = mac_->getHarqRxBuffers();
 
+    checkSchedulerConsistency_ = mac_->par("checkSchedulerConsistency");
+
     // Create LteScheduler. One per carrier
     SchedDiscipline discipline = mac_->getSchedDiscipline(direction_);
 
@@ -112,6 +122,8 @@ void LteSchedulerEnb::initialize(Direction dir, LteMacEnb *mac, Binder *binder)
     // Create Allocator
     if (discipline == ALLOCATOR_BESTFIT)                                            // NOTE: create this type of allocator for every scheduler using Frequency Reuse
         allocator_ = new LteAllocationModuleFrequencyReuse(mac_, direction_);
+    else if (mac_->par("bitmapAllocator").boolValue())
+        allocator_ = new LteAllocationModuleBitmap(mac_, direction_);
     else
         allocator_ = new LteAllocationModule(mac_, direction_);
 
@@ -132,6 +144,7 @@ std::map<GHz, LteMacScheduleList> *LteSchedulerEnb::schedule()
     for (auto & [key, value] : scheduleList_)
         value.clear();
     allocatedCws_.clear();
+    bytesOnNRbs_.clear();
 
     // clean the allocator
     resetAllocator();
@@ -155,6 +168,8 @@ std::map<GHz, LteMacScheduleList> *LteSchedulerEnb::schedule()
             EV << "___________________________start SCHED ________________________________" << endl;
             scheduler->updateSchedulingInfo();
             scheduler->schedule();
+            if (checkSchedulerConsistency_)
+                scheduler->checkConsistency();
             EV << "____________________________ end SCHED ________________________________" << endl;
         }
     }
@@ -342,7 +357,12 @@ unsigned int LteSchedulerEnb::scheduleGrant(MacCid cid, unsigned int bytes, bool
         unsigned int cwAllocatedBlocks = 0; // used by uplink only, for signaling cw blocks usage to schedule list
         unsigned int vQueueItemCounter = 0; // per codeword MAC SDUs counter
 
+        // search for already allocated codeword (it does not change while looping on bands)
         unsigned int allocatedCws = 0;
+        auto cwIt = allocatedCws_.find(nodeId);
+        if (cwIt != allocatedCws_.end())
+            allocatedCws = cwIt->second;
+
         unsigned int size = (*bandLim).size();
         for (unsigned int i = 0; i < size; ++i) { // for each band
             // save the band and the relative limit
@@ -356,10 +376,6 @@ unsigned int LteSchedulerEnb::scheduleGrant(MacCid cid, unsigned int bytes, bool
                 continue;
             }
 
-            // search for already allocated codeword
-            if (allocatedCws_.find(nodeId) != allocatedCws_.end())
-                allocatedCws = allocatedCws_.at(nodeId);
-
             unsigned int bandAvailableBytes = 0;
             unsigned int bandAvailableBlocks = 0;
             // if there is a previous blocks allocation on the first codeword, blocks allocation is already available
@@ -368,7 +384,7 @@ unsigned int LteSchedulerEnb::scheduleGrant(MacCid cid, unsigned int bytes, bool
                 int b1 = allocator_->getBlocks(antenna, b, nodeId);
                 // limit eventually allocated blocks on other codeword to limit for current cw
                 bandAvailableBlocks = (limitBl ? (b1 > limit ? limit : b1) : b1);
-                bandAvailableBytes = mac_->getAmc()->computeBytesOnNRbs(nodeId, b, cw, bandAvailableBlocks, dir, carrierFrequency);
+                bandAvailableBytes = bytesOnNRbs(nodeId, b, cw, bandAvailableBlocks, dir, carrierFrequency);
             }
             else { // if limit is expressed in blocks, limit value must be passed to availableBytes function
                 bandAvailableBlocks = allocator_->availableBlocks(nodeId, antenna, b);
@@ -768,6 +784,12 @@ void LteSchedulerEnb::backlog(MacCid cid)
         schedulerItem->notifyActiveConnection(cid);
 }
 
+void LteSchedulerEnb::txParamsChanged(MacNodeId nodeId)
+{
+    for (auto* schedulerItem : scheduler_)
+        schedulerItem->notifyTxParamsChange(nodeId);
+}
+
 unsigned int LteSchedulerEnb::readPerUeAllocatedBlocks(const MacNodeId nodeId,
         const Remote antenna, const Band b)
 {
@@ -846,12 +868,28 @@ unsigned int LteSchedulerEnb::availableBytes(const MacNodeId id,
     if (limit != -1)
         blocks = (blocks > limit) ? limit : blocks;
 
-    unsigned int bytes = mac_->getAmc()->computeBytesOnNRbs(id, b, cw, blocks, dir, carrierFrequency);
+    unsigned int bytes = bytesOnNRbs(id, b, cw, blocks, dir, carrierFrequency);
     EV << "LteSchedulerEnb::availableBytes MacNodeId " << id << " blocks [" << blocks << "], bytes [" << bytes << "]" << endl;
 
     return bytes;
 }
 
+unsigned int LteSchedulerEnb::bytesOnNRbs(const MacNodeId id, Band b, Codeword cw, unsigned int blocks, Direction dir, GHz carrierFrequency)
+{
+    // the cache is also valid outside schedule(), as long as the slot does not change
+    if (bytesOnNRbsTime_ != NOW) {
+        bytesOnNRbs_.clear();
+        bytesOnNRbsTime_ = NOW;
+    }
+
+    std::vector<unsigned int>& bytes = bytesOnNRbs_[std::make_tuple(id, cw, dir, carrierFrequency)];
+    if (blocks >= bytes.size())
+        bytes.resize(blocks + 1, UINT_MAX);
+    if (bytes[blocks] == UINT_MAX)
+        bytes[blocks] = mac_->getAmc()->computeBytesOnNRbs(id, b, cw, blocks, dir, carrierFrequency);
+    return bytes[blocks];
+}
+
 unsigned int LteSchedulerEnb::availableBytesBackgroundUe(const MacNodeId id, Remote antenna, Band b, Direction dir, GHz carrierFrequency, int limit)
 {
     EV << "LteSchedulerEnb::availableBytes MacNodeId " << id << " Antenna " << dasToA(antenna) << " band " << b << endl;
@@ -904,6 +942,8 @@ LteScheduler *LteSchedulerEnb::getScheduler(SchedDiscipline discipline)
             return new LteDrr(binder_);
         case PF:
             return new LtePf(binder_, mac_->par("pfAlpha").doubleValue());
+        case PF_INCREMENTAL:
+            return new LtePfIncremental(binder_, mac_->par("pfAlpha").doubleValue());
         case MAXCI:
             return new LteMaxCi(binder_);
         case MAXCI_MB:
@@ -971,6 +1011,9 @@ void LteSchedulerEnb::removeActiveConnections(MacNodeId nodeId)
         else
             ++it;
     }
+
+    for (auto* schedulerItem : scheduler_)
+        schedulerItem->notifyNodeRemoval(nodeId);
 }
 
 } //namespace
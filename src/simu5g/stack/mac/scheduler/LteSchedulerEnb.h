@@ -13,6 +13,8 @@
 #ifndef _LTE_LTESCHEDULERENB_H_
 #define _LTE_LTESCHEDULERENB_H_
 
+#include <tuple>
+
 #include "simu5g/common/LteCommon.h"
 #include "simu5g/stack/mac/buffer/harq/LteHarqBufferTx.h"
 #include "simu5g/stack/mac/allocator/LteAllocatorUtils.h"
@@ -41,6 +43,7 @@ class LteSchedulerEnb
     friend class LteScheduler;
     friend class LteDrr;
     friend class LtePf;
+    friend class LtePfIncremental;
     friend class LteMaxCi;
     friend class LteMaxCiMultiband;
     friend class LteMaxCiOptMB;
@@ -111,6 +114,17 @@ class LteSchedulerEnb
     // pre-made BandLimit structure used when no band limit is given to the scheduler
     std::vector<BandLimit> emptyBandLim_;
 
+    /*
+     * Bytes that fit into N blocks (vector index) for a given UE, codeword, direction and carrier.
+     * The AMC computes the same amount on every band and the transmission parameters of the UEs do not
+     * change within a slot, hence each entry is computed once per slot and reused for all bands and grants
+     */
+    std::map<std::tuple<MacNodeId, Codeword, Direction, GHz>, std::vector<unsigned int>> bytesOnNRbs_;
+    simtime_t bytesOnNRbsTime_;
+
+    // if true, the scheduling modules check their structures after each slot (for testing)
+    bool checkSchedulerConsistency_ = false;
+
     // @author Alessandro Noferi
     double utilization_ = 0; // it records the utilization in the last TTI
 
@@ -162,6 +176,13 @@ class LteSchedulerEnb
      */
     void backlog(MacCid cid);
 
+    /**
+     * Notifies the LteSchedulers that the transmission parameters
+     * of a node have changed, e.g., upon the reception of feedback.
+     * @param nodeId node identifier
+     */
+    void txParamsChanged(MacNodeId nodeId);
+
     /**
      * Get/Set current available Resource Blocks.
      */
@@ -342,6 +363,12 @@ class LteSchedulerEnb
      */
     unsigned int availableBytesBackgroundUe(const MacNodeId id, const Remote antenna, Band b, Direction dir, GHz carrierFrequency, int limit = -1);
 
+    /**
+     * Returns the number of bytes that fit into the given number of blocks for a given user and codeword,
+     * as computed by the AMC module. Results are cached for the current slot.
+     */
+    unsigned int bytesOnNRbs(const MacNodeId id, Band b, Codeword cw, unsigned int blocks, Direction dir, GHz carrierFrequency);
+
     unsigned int allocatedCws(MacNodeId nodeId)
     {
         return allocatedCws_[nodeId];
@@ -11,6 +11,9 @@
 //
 
 #include "simu5g/stack/mac/scheduling_modules/LtePf.h"
+
+#include <algorithm>
+
 #include "simu5g/stack/mac/scheduler/LteSchedulerEnb.h"
 
 namespace simu5g {
@@ -23,25 +26,24 @@ void LtePf::prepareSchedule()
     EV << NOW << "LtePf::execSchedule Direction: " << ((direction_ == DL) ? " DL " : " UL ") << endl;
 
     // Clear structures
-    grantedBytes_.clear();
-
-    // Create a working copy of the active set
-    activeConnectionTempSet_ = *activeConnectionSet_;
+    connections_.clear();
+    score_.clear();
 
     // Build the score list by cycling through the active connections.
-    ScoreList score;
-
-    for (const auto& cid : carrierActiveConnectionSet_) {
+    // Connections that become inactive are erased directly from the active set, which is not
+    // modified by anyone else until commitSchedule()
+    for (auto cit = carrierActiveConnectionSet_.begin(); cit != carrierActiveConnectionSet_.end(); ) {
+        MacCid cid = *cit;
         MacNodeId nodeId = cid.getNodeId();
-        grantedBytes_[cid] = 0;
+        connections_.push_back({cid, &pfRate_[cid], 0});
 
         if (nodeId == NODEID_NONE || !binder_->nodeExists(nodeId)) {
             // node has left the simulation - erase corresponding CIDs
             activeConnectionSet_->erase(cid);
-            activeConnectionTempSet_.erase(cid);
-            carrierActiveConnectionSet_.erase(cid);
+            cit = carrierActiveConnectionSet_.erase(cit);
             continue;
         }
+        ++cit;
 
         // if we are allocating the UL subframe, this connection may be either UL or D2D
         Direction dir;
@@ -50,14 +52,6 @@ void LtePf::prepareSchedule()
         else
             dir = DL;
 
-        // check if node is still a valid node in the simulation - might have been dynamically removed
-        if (!binder_->nodeExists(nodeId)) {
-            activeConnectionTempSet_.erase(cid);
-            carrierActiveConnectionSet_.erase(cid);
-            EV << "CID " << cid << " of node " << nodeId << " removed from active connection set - no such node in Binder";
-            continue;
-        }
-
         // compute available blocks for the current user
         const UserTxParams& info = eNbScheduler_->mac_->getAmc()->computeTxParams(nodeId, dir, carrierFrequency_);
         const std::set<Band>& bands = info.readBands();
@@ -89,24 +83,25 @@ void LtePf::prepareSchedule()
         }
 
         double s = .0;
+        double pfRate = *connections_.back().pfRate;
 
-        if (pfRate_.find(cid) == pfRate_.end()) pfRate_[cid] = 0;
-        if (pfRate_[cid] < scoreEpsilon_) s = 1.0 / scoreEpsilon_;
-        else if (availableBlocks > 0) s = ((availableBytes / availableBlocks) / pfRate_[cid]) + uniform(getEnvir()->getRNG(0), -scoreEpsilon_ / 2.0, scoreEpsilon_ / 2.0);
+        if (pfRate < scoreEpsilon_) s = 1.0 / scoreEpsilon_;
+        else if (availableBlocks > 0) s = ((availableBytes / availableBlocks) / pfRate) + uniform(getEnvir()->getRNG(0), -scoreEpsilon_ / 2.0, scoreEpsilon_ / 2.0);
         else s = 0.0;
 
         // Create a new score descriptor for the connection, where the score is equal to the ratio between bytes per slot and long term rate
-        ScoreDesc desc(cid, s);
-        score.push(desc);
+        score_.emplace_back(connections_.size() - 1, s);
+        std::push_heap(score_.begin(), score_.end(), std::less<ScoreDesc>());
 
         EV << NOW << "LtePf::execSchedule CID " << cid << "- Score = " << s << endl;
     }
 
     // Schedule the connections in score order.
-    while (!score.empty()) {
+    while (!score_.empty()) {
         // Pop the top connection from the list.
-        ScoreDesc current = score.top();
-        MacCid cid = current.x_; // The CID
+        ScoreDesc current = score_.front();
+        PfConnection& connection = connections_[current.x_];
+        MacCid cid = connection.cid; // The CID
 
         EV << NOW << "LtePf::execSchedule @@@@@@@@@@@@@@@@@@@@@@@@@@@@@@" << endl;
         EV << NOW << "LtePf::execSchedule CID: " << cid;
@@ -119,7 +114,7 @@ void LtePf::prepareSchedule()
 
         unsigned int granted = requestGrant(cid, 4294967295U, terminate, active, eligible);
 
-        grantedBytes_[cid] += granted;
+        connection.granted += granted;
 
         EV << NOW << "LtePf::execSchedule Granted: " << granted << " bytes" << endl;
 
@@ -131,7 +126,8 @@ void LtePf::prepareSchedule()
 
         // Pop the descriptor from the score list if the active or eligible flag are clear.
         if (!active || !eligible) {
-            score.pop();
+            std::pop_heap(score_.begin(), score_.end(), std::less<ScoreDesc>());
+            score_.pop_back();
 
             if (!eligible)
                 EV << NOW << "LtePf::execSchedule NOT ELIGIBLE " << endl;
@@ -140,8 +136,8 @@ void LtePf::prepareSchedule()
         // Set the connection as inactive if indicated by the grant ().
         if (!active) {
             EV << NOW << "LtePf::execSchedule NOT ACTIVE" << endl;
-            activeConnectionTempSet_.erase(current.x_);
-            carrierActiveConnectionSet_.erase(current.x_);
+            activeConnectionSet_->erase(cid);
+            carrierActiveConnectionSet_.erase(cid);
         }
     }
 }
@@ -150,7 +146,7 @@ void LtePf::commitSchedule()
 {
     unsigned int total = eNbScheduler_->resourceBlocks_;
 
-    for (const auto& [cid, granted] : grantedBytes_) {
+    for (const auto& [cid, pfRate, granted] : connections_) {
         EV << NOW << " LtePf::storeSchedule @@@@@@@@@@@@@@@@@@@@@@@@@@@@@@" << endl;
         EV << NOW << " LtePf::storeSchedule CID: " << cid << endl;
         EV << NOW << " LtePf::storeSchedule Direction: " << ((direction_ == DL) ? "DL" : "UL") << endl;
@@ -166,13 +162,11 @@ void LtePf::commitSchedule()
         EV << NOW << " LtePf::storeSchedule Short Term Rate " << shortTermRate << endl;
 
         // Updating the long term rate
-        double& longTermRate = pfRate_[cid];
+        double& longTermRate = *pfRate;
         longTermRate = (1.0 - pfAlpha_) * longTermRate + pfAlpha_ * shortTermRate;
 
         EV << NOW << "LtePf::storeSchedule Long Term Rate = " << longTermRate;
     }
-
-    *activeConnectionSet_ = activeConnectionTempSet_;
 }
 
 } //namespace
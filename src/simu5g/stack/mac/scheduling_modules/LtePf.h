@@ -22,14 +22,26 @@ class LtePf : public LteScheduler
   protected:
 
     typedef std::map<MacCid, double> PfRate;
-    typedef SortedDesc<MacCid, double> ScoreDesc;
-    typedef std::priority_queue<ScoreDesc> ScoreList;
+
+    //! Connection considered in the current slot
+    struct PfConnection
+    {
+        MacCid cid;
+        double *pfRate;         // entry of the connection in pfRate_
+        unsigned int granted;   // granted bytes
+    };
+
+    //! Score descriptor, identifying the connection by its index in connections_
+    typedef SortedDesc<unsigned int, double> ScoreDesc;
 
     //! Long-term rates, used by PF scheduling.
     PfRate pfRate_;
 
-    //! Granted bytes
-    std::map<MacCid, unsigned int> grantedBytes_;
+    //! Connections of the current slot, sorted by CID. Reused across slots
+    std::vector<PfConnection> connections_;
+
+    //! Heap of the scores, managed as std::priority_queue does. Reused across slots
+    std::vector<ScoreDesc> score_;
 
     //! Smoothing factor for proportional fair scheduler.
     double pfAlpha_;
@@ -0,0 +1,436 @@
+//
+//                  Simu5G
+//
+// Copyright (C) 2012-2021 Giovanni Nardini, Giovanni Stea, Antonio Virdis et al. (University of Pisa)
+// Copyright (C) 2022-2026 Giovanni Nardini, Giovanni Stea et al. (University of Pisa)
+//
+// This file is part of a software released under the license included in file
+// "license.pdf". Please read LICENSE and README files before using it.
+// The above files and the present reference are part of the software itself,
+// and cannot be removed from it.
+//
+
+#include "simu5g/stack/mac/scheduling_modules/LtePfIncremental.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+
+#include "simu5g/stack/mac/scheduler/LteSchedulerEnb.h"
+
+namespace simu5g {
+
+using namespace omnetpp;
+
+LtePfIncremental::LtePfIncremental(Binder *binder, double pfAlpha) :
+    LteScheduler(binder),
+    pfAlpha_(pfAlpha)
+{
+    // the global scale of the rates would drop to zero
+    if (pfAlpha_ >= 1.0)
+        throw cRuntimeError("LtePfIncremental: pfAlpha must be lower than 1 (%f)", pfAlpha_);
+}
+
+void LtePfIncremental::schedule()
+{
+    activeConnectionSet_ = eNbScheduler_->readActiveConnections();
+
+    // the connections of this carrier are tracked by notifyActiveConnection(),
+    // hence there is no need to build the carrier active set
+
+    prepareSchedule();
+    commitSchedule();
+}
+
+void LtePfIncremental::prepareSchedule()
+{
+    EV << NOW << "LtePfIncremental::execSchedule ############### eNodeB " << eNbScheduler_->mac_->getMacNodeId() << " ###############" << endl;
+    EV << NOW << "LtePfIncremental::execSchedule Direction: " << ((direction_ == DL) ? " DL " : " UL ") << endl;
+
+    // refresh the scores of the connections that were activated or received new feedback
+    for (unsigned int slot : dirtySlots_) {
+        dirty_[slot] = false;
+        if (active_[slot])
+            refresh(slot);
+    }
+    dirtySlots_.clear();
+
+    // Schedule the connections in score order.
+    while (!heap_.empty()) {
+        unsigned int slot = heap_.front();
+        MacCid cid = cids_[slot];
+        MacNodeId nodeId = cid.getNodeId();
+
+        if (nodeId == NODEID_NONE || !binder_->nodeExists(nodeId) || activeConnectionSet_->find(cid) == activeConnectionSet_->end()) {
+            // node has left the simulation, or its connections have been removed (e.g., upon handover)
+            activeConnectionSet_->erase(cid);
+            heapRemove(slot);
+            deactivatedSlots_.push_back(slot);
+            continue;
+        }
+
+        // all the codewords have been allocated, e.g., to retransmissions. Skip for this slot
+        if (eNbScheduler_->allocatedCws(nodeId) == codewords_[slot]) {
+            heapRemove(slot);
+            skippedSlots_.push_back(slot);
+            continue;
+        }
+
+        EV << NOW << "LtePfIncremental::execSchedule CID: " << cid << " Score: " << score_[slot] << endl;
+
+        // Grant data to that connection.
+        bool terminate = false;
+        bool active = true;
+        bool eligible = true;
+
+        unsigned int granted = requestGrant(cid, 4294967295U, terminate, active, eligible);
+
+        if (granted > 0 && granted_[slot] == 0)
+            servedSlots_.push_back(slot);
+        granted_[slot] += granted;
+
+        EV << NOW << "LtePfIncremental::execSchedule Granted: " << granted << " bytes" << endl;
+
+        // Exit immediately if the terminate flag is set.
+        if (terminate) {
+            EV << NOW << "LtePfIncremental::execSchedule TERMINATE " << endl;
+            break;
+        }
+
+        // Remove the connection from the heap if the active or eligible flag are clear.
+        if (!active || !eligible) {
+            heapRemove(slot);
+
+            if (!active) {
+                EV << NOW << "LtePfIncremental::execSchedule NOT ACTIVE" << endl;
+                activeConnectionSet_->erase(cid);
+                deactivatedSlots_.push_back(slot);
+            }
+            else {
+                EV << NOW << "LtePfIncremental::execSchedule NOT ELIGIBLE " << endl;
+                skippedSlots_.push_back(slot);
+            }
+        }
+    }
+}
+
+void LtePfIncremental::commitSchedule()
+{
+    unsigned int total = eNbScheduler_->resourceBlocks_;
+
+    // decay the rates of all the active connections at once
+    if (rateScale_ * (1.0 - pfAlpha_) < minRateScale_)
+        normalizeRates();
+    rateScale_ *= 1.0 - pfAlpha_;
+
+    for (unsigned int slot : servedSlots_) {
+        double shortTermRate = (total > 0) ? double(granted_[slot]) / double(total) : 0.0;
+        rate_[slot] += pfAlpha_ * shortTermRate / rateScale_;
+        granted_[slot] = 0;
+
+        EV << NOW << " LtePfIncremental::storeSchedule CID: " << cids_[slot] << " Long Term Rate = " << rate_[slot] * rateScale_ << endl;
+    }
+
+    // inactive connections keep their rate until they are activated again
+    for (unsigned int slot : deactivatedSlots_) {
+        rate_[slot] *= rateScale_;
+        active_[slot] = false;
+    }
+
+    for (unsigned int slot : servedSlots_)
+        updateScore(slot);
+    for (unsigned int slot : skippedSlots_)
+        updateScore(slot);
+
+    servedSlots_.clear();
+    deactivatedSlots_.clear();
+    skippedSlots_.clear();
+}
+
+void LtePfIncremental::notifyActiveConnection(MacCid cid)
+{
+    EV << NOW << "LtePfIncremental::notify CID: " << cid << endl;
+
+    const UeSet& carrierUeSet = binder_->getCarrierUeSet(carrierFrequency_);
+    if (carrierUeSet.find(cid.getNodeId()) == carrierUeSet.end())
+        return;
+
+    unsigned int slot = getSlot(cid);
+    if (!active_[slot]) {
+        rate_[slot] /= rateScale_;
+        active_[slot] = true;
+        markDirty(slot);
+    }
+}
+
+void LtePfIncremental::notifyTxParamsChange(MacNodeId nodeId)
+{
+    auto it = nodeSlots_.find(nodeId);
+    if (it == nodeSlots_.end())
+        return;
+
+    for (unsigned int slot : it->second) {
+        if (active_[slot])
+            markDirty(slot);
+    }
+}
+
+void LtePfIncremental::notifyNodeRemoval(MacNodeId nodeId)
+{
+    auto it = nodeSlots_.find(nodeId);
+    if (it == nodeSlots_.end())
+        return;
+
+    EV << NOW << "LtePfIncremental::notifyNodeRemoval - removing the connections of node " << nodeId << endl;
+
+    // remove the highest slots first, so that the slots moved in place of the removed ones
+    // never belong to the removed node
+    std::vector<unsigned int> slots = std::move(it->second);
+    nodeSlots_.erase(it);
+    std::sort(slots.begin(), slots.end(), std::greater<unsigned int>());
+    for (unsigned int slot : slots)
+        removeSlot(slot);
+}
+
+void LtePfIncremental::checkConsistency()
+{
+    unsigned int numSlots = cids_.size();
+    if (slots_.size() != numSlots)
+        throw cRuntimeError("LtePfIncremental::checkConsistency - %zu connections indexed, %u slots", slots_.size(), numSlots);
+
+    unsigned int numNodeSlots = 0;
+    for (const auto& [nodeId, slots] : nodeSlots_) {
+        for (unsigned int slot : slots) {
+            if (slot >= numSlots || cids_[slot].getNodeId() != nodeId)
+                throw cRuntimeError("LtePfIncremental::checkConsistency - slot %u wrongly listed for node %hu", slot, num(nodeId));
+        }
+        numNodeSlots += slots.size();
+    }
+    if (numNodeSlots != numSlots)
+        throw cRuntimeError("LtePfIncremental::checkConsistency - %u slots listed by node, %u slots", numNodeSlots, numSlots);
+
+    unsigned int numInHeap = 0;
+    for (unsigned int slot = 0; slot < numSlots; slot++) {
+        auto it = slots_.find(cids_[slot]);
+        if (it == slots_.end() || it->second != slot)
+            throw cRuntimeError("LtePfIncremental::checkConsistency - connection %s is not indexed by slot %u", cids_[slot].str().c_str(), slot);
+        if (granted_[slot] != 0)
+            throw cRuntimeError("LtePfIncremental::checkConsistency - grant of connection %s not committed", cids_[slot].str().c_str());
+        if (heapPos_[slot] < 0)
+            continue;
+
+        numInHeap++;
+        if ((unsigned int)heapPos_[slot] >= heap_.size() || heap_[heapPos_[slot]] != slot)
+            throw cRuntimeError("LtePfIncremental::checkConsistency - wrong heap position of connection %s", cids_[slot].str().c_str());
+        if (!active_[slot] || bytesPerBlock_[slot] == 0.0)
+            throw cRuntimeError("LtePfIncremental::checkConsistency - connection %s is in the heap but cannot be scheduled", cids_[slot].str().c_str());
+        double score = (rate_[slot] > 0.0) ? bytesPerBlock_[slot] / rate_[slot] : std::numeric_limits<double>::max();
+        if (score != score_[slot])
+            throw cRuntimeError("LtePfIncremental::checkConsistency - stale score of connection %s (%g instead of %g)", cids_[slot].str().c_str(), score_[slot], score);
+    }
+    if (numInHeap != heap_.size())
+        throw cRuntimeError("LtePfIncremental::checkConsistency - %zu connections in the heap, %u expected", heap_.size(), numInHeap);
+
+    for (unsigned int pos = 1; pos < heap_.size(); pos++) {
+        if (higher(heap_[pos], heap_[(pos - 1) / 2]))
+            throw cRuntimeError("LtePfIncremental::checkConsistency - heap order violated at position %u", pos);
+    }
+}
+
+unsigned int LtePfIncremental::getSlot(MacCid cid)
+{
+    auto it = slots_.find(cid);
+    if (it != slots_.end())
+        return it->second;
+
+    unsigned int slot = cids_.size();
+    cids_.push_back(cid);
+    rate_.push_back(0.0);
+    bytesPerBlock_.push_back(0.0);
+    score_.push_back(0.0);
+    codewords_.push_back(0);
+    granted_.push_back(0);
+    heapPos_.push_back(-1);
+    active_.push_back(false);
+    dirty_.push_back(false);
+
+    slots_[cid] = slot;
+    nodeSlots_[cid.getNodeId()].push_back(slot);
+    return slot;
+}
+
+void LtePfIncremental::removeSlot(unsigned int slot)
+{
+    if (heapPos_[slot] >= 0)
+        heapRemove(slot);
+    if (dirty_[slot])
+        dirtySlots_.erase(std::find(dirtySlots_.begin(), dirtySlots_.end(), slot));
+    slots_.erase(cids_[slot]);
+
+    unsigned int last = cids_.size() - 1;
+    if (slot != last) {
+        cids_[slot] = cids_[last];
+        rate_[slot] = rate_[last];
+        bytesPerBlock_[slot] = bytesPerBlock_[last];
+        score_[slot] = score_[last];
+        codewords_[slot] = codewords_[last];
+        granted_[slot] = granted_[last];
+        heapPos_[slot] = heapPos_[last];
+        active_[slot] = active_[last];
+        dirty_[slot] = dirty_[last];
+
+        // redirect the references to the moved slot. Ties are broken by slot, hence the
+        // moved connection may have to move up in the heap
+        if (heapPos_[slot] >= 0) {
+            heap_[heapPos_[slot]] = slot;
+            heapSiftUp(heapPos_[slot]);
+        }
+        if (dirty_[slot])
+            *std::find(dirtySlots_.begin(), dirtySlots_.end(), last) = slot;
+        slots_[cids_[slot]] = slot;
+        std::vector<unsigned int>& nodeSlots = nodeSlots_[cids_[slot].getNodeId()];
+        *std::find(nodeSlots.begin(), nodeSlots.end(), last) = slot;
+    }
+
+    cids_.pop_back();
+    rate_.pop_back();
+    bytesPerBlock_.pop_back();
+    score_.pop_back();
+    codewords_.pop_back();
+    granted_.pop_back();
+    heapPos_.pop_back();
+    active_.pop_back();
+    dirty_.pop_back();
+}
+
+void LtePfIncremental::markDirty(unsigned int slot)
+{
+    if (!dirty_[slot]) {
+        dirty_[slot] = true;
+        dirtySlots_.push_back(slot);
+    }
+}
+
+void LtePfIncremental::refresh(unsigned int slot)
+{
+    MacCid cid = cids_[slot];
+    MacNodeId nodeId = cid.getNodeId();
+    bytesPerBlock_[slot] = 0.0;
+
+    if (nodeId != NODEID_NONE && binder_->nodeExists(nodeId)) {
+        // if we are allocating the UL subframe, this connection may be either UL or D2D
+        Direction dir;
+        if (direction_ == UL)
+            dir = (cid.getLcid() == D2D_SHORT_BSR) ? D2D : (cid.getLcid() == D2D_MULTI_SHORT_BSR) ? D2D_MULTI : direction_;
+        else
+            dir = DL;
+
+        const UserTxParams& info = eNbScheduler_->mac_->getAmc()->computeTxParams(nodeId, dir, carrierFrequency_);
+        const std::set<Band>& bands = info.readBands();
+        codewords_[slot] = info.getLayers().size();
+
+        bool cqiNull = false;
+        for (unsigned int i = 0; i < codewords_[slot]; i++) {
+            if (info.readCqiVector()[i] == 0)
+                cqiNull = true;
+        }
+
+        if (!cqiNull && !bands.empty()) {
+            unsigned int bytes = 0;
+            for (Band band : bands)
+                bytes += eNbScheduler_->mac_->getAmc()->computeBytesOnNRbs(nodeId, band, 1, dir, carrierFrequency_);
+            bytesPerBlock_[slot] = double(bytes) / bands.size();
+        }
+    }
+
+    updateScore(slot);
+}
+
+void LtePfIncremental::updateScore(unsigned int slot)
+{
+    if (!active_[slot] || bytesPerBlock_[slot] == 0.0) {
+        if (heapPos_[slot] >= 0)
+            heapRemove(slot);
+        return;
+    }
+
+    double oldScore = score_[slot];
+    score_[slot] = (rate_[slot] > 0.0) ? bytesPerBlock_[slot] / rate_[slot] : std::numeric_limits<double>::max();
+
+    if (heapPos_[slot] < 0)
+        heapPush(slot);
+    else if (score_[slot] > oldScore)
+        heapSiftUp(heapPos_[slot]);
+    else
+        heapSiftDown(heapPos_[slot]);
+}
+
+void LtePfIncremental::normalizeRates()
+{
+    for (unsigned int slot = 0; slot < cids_.size(); slot++) {
+        if (!active_[slot])
+            continue;
+        rate_[slot] *= rateScale_;
+        score_[slot] = (rate_[slot] > 0.0) ? bytesPerBlock_[slot] / rate_[slot] : std::numeric_limits<double>::max();
+    }
+    rateScale_ = 1.0;
+
+    // the order is preserved up to rounding, rebuild the heap anyway
+    for (unsigned int pos = heap_.size() / 2; pos-- > 0; )
+        heapSiftDown(pos);
+}
+
+void LtePfIncremental::heapPush(unsigned int slot)
+{
+    heap_.push_back(slot);
+    heapPos_[slot] = heap_.size() - 1;
+    heapSiftUp(heap_.size() - 1);
+}
+
+void LtePfIncremental::heapRemove(unsigned int slot)
+{
+    unsigned int pos = heapPos_[slot];
+    unsigned int last = heap_.back();
+    heap_.pop_back();
+    heapPos_[slot] = -1;
+
+    if (pos < heap_.size()) {
+        heapPlace(pos, last);
+        heapSiftUp(pos);
+        heapSiftDown(heapPos_[last]);
+    }
+}
+
+void LtePfIncremental::heapSiftUp(unsigned int pos)
+{
+    unsigned int slot = heap_[pos];
+    while (pos > 0) {
+        unsigned int parent = (pos - 1) / 2;
+        if (!higher(slot, heap_[parent]))
+            break;
+        heapPlace(pos, heap_[parent]);
+        pos = parent;
+    }
+    heapPlace(pos, slot);
+}
+
+void LtePfIncremental::heapSiftDown(unsigned int pos)
+{
+    unsigned int slot = heap_[pos];
+    unsigned int size = heap_.size();
+    while (true) {
+        unsigned int child = 2 * pos + 1;
+        if (child >= size)
+            break;
+        if (child + 1 < size && higher(heap_[child + 1], heap_[child]))
+            child++;
+        if (!higher(heap_[child], slot))
+            break;
+        heapPlace(pos, heap_[child]);
+        pos = child;
+    }
+    heapPlace(pos, slot);
+}
+
+} //namespace
+
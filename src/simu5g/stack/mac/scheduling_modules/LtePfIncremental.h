@@ -0,0 +1,156 @@
+//
+//                  Simu5G
+//
+// Copyright (C) 2012-2021 Giovanni Nardini, Giovanni Stea, Antonio Virdis et al. (University of Pisa)
+// Copyright (C) 2022-2026 Giovanni Nardini, Giovanni Stea et al. (University of Pisa)
+//
+// This file is part of a software released under the license included in file
+// "license.pdf". Please read LICENSE and README files before using it.
+// The above files and the present reference are part of the software itself,
+// and cannot be removed from it.
+//
+
+#ifndef _LTE_LTEPFINCREMENTAL_H_
+#define _LTE_LTEPFINCREMENTAL_H_
+
+#include "simu5g/stack/mac/scheduler/LteScheduler.h"
+
+namespace simu5g {
+
+/**
+ * Proportional Fair scheduler whose per-slot cost is proportional to the number of
+ * connections that changed, rather than to the number of active connections.
+ *
+ * Connections are kept in dense per-connection arrays and their scores in an indexed
+ * max-heap that persists across slots. The long-term rate of every connection decays by
+ * (1 - pfAlpha) at each slot, which does not change the order of the scores: the decay is
+ * therefore applied to a global scale factor, and only the rates of the served connections
+ * are updated. Scores are refreshed when a connection is activated, served, or when its node
+ * reports new feedback.
+ *
+ * Unlike LtePf, the achievable rate of a connection is computed on all the bands of the
+ * carrier, regardless of the RBs used by retransmissions in the current slot, and scores
+ * are not randomly blurred. Results thus differ from LtePf.
+ */
+class LtePfIncremental : public LteScheduler
+{
+  protected:
+
+    //! Connection identifiers, indexed by connection slot
+    std::vector<MacCid> cids_;
+
+    //! Long-term rates. For active connections the actual rate is rate_ * rateScale_
+    std::vector<double> rate_;
+
+    //! Bytes per block achievable by the connection, according to the latest feedback. Zero if not schedulable
+    std::vector<double> bytesPerBlock_;
+
+    //! Scores, i.e., bytesPerBlock_ / rate_ (scaled)
+    std::vector<double> score_;
+
+    //! Number of codewords of the connection, according to the latest feedback
+    std::vector<unsigned int> codewords_;
+
+    //! Bytes granted in the current slot
+    std::vector<unsigned int> granted_;
+
+    //! Position of the connection in heap_, -1 if it is not in the heap
+    std::vector<int> heapPos_;
+
+    //! True if the connection is active (i.e., its rate is scaled by rateScale_)
+    std::vector<bool> active_;
+
+    //! True if the score of the connection must be refreshed before the next slot
+    std::vector<bool> dirty_;
+
+    //! Max-heap of the slots of the schedulable connections, ordered by score
+    std::vector<unsigned int> heap_;
+
+    //! Slot of each connection
+    std::map<MacCid, unsigned int> slots_;
+
+    //! Slots of the connections of each node
+    std::map<MacNodeId, std::vector<unsigned int>> nodeSlots_;
+
+    //! Connections to refresh, served, deactivated and temporarily removed from the heap in the current slot
+    std::vector<unsigned int> dirtySlots_;
+    std::vector<unsigned int> servedSlots_;
+    std::vector<unsigned int> deactivatedSlots_;
+    std::vector<unsigned int> skippedSlots_;
+
+    //! Global scale of the long-term rates of the active connections
+    double rateScale_ = 1.0;
+
+    //! Below this value, the scale is folded into the rates
+    const double minRateScale_ = 1e-200;
+
+    //! Smoothing factor for proportional fair scheduler.
+    double pfAlpha_;
+
+    //! Returns the slot of the given connection, creating it if needed
+    unsigned int getSlot(MacCid cid);
+
+    //! Removes the given slot, moving the last one in its place
+    void removeSlot(unsigned int slot);
+
+    //! Marks the score of the given slot to be refreshed before the next slot
+    void markDirty(unsigned int slot);
+
+    //! Recomputes the achievable rate of the given slot and updates its position in the heap
+    void refresh(unsigned int slot);
+
+    //! Recomputes the score of the given slot from its rate and updates its position in the heap
+    void updateScore(unsigned int slot);
+
+    //! Folds rateScale_ into the rates of the active connections
+    void normalizeRates();
+
+    // Indexed heap operations
+    bool higher(unsigned int a, unsigned int b) const
+    {
+        return score_[a] > score_[b] || (score_[a] == score_[b] && a < b);
+    }
+
+    void heapPush(unsigned int slot);
+    void heapRemove(unsigned int slot);
+    void heapSiftUp(unsigned int pos);
+    void heapSiftDown(unsigned int pos);
+    void heapPlace(unsigned int pos, unsigned int slot)
+    {
+        heap_[pos] = slot;
+        heapPos_[slot] = pos;
+    }
+
+  public:
+
+    double getPfAlpha()
+    {
+        return pfAlpha_;
+    }
+
+    // Scheduling functions ********************************************************************
+
+    void schedule() override;
+
+    void prepareSchedule() override;
+
+    void commitSchedule() override;
+
+    // *****************************************************************************************
+
+    void notifyActiveConnection(MacCid cid) override;
+
+    void notifyTxParamsChange(MacNodeId nodeId) override;
+
+    void notifyNodeRemoval(MacNodeId nodeId) override;
+
+    void checkConsistency() override;
+
+    LtePfIncremental(Binder *binder, double pfAlpha);
+
+};
+
+} //namespace
+
+#endif // _LTE_LTEPFINCREMENTAL_H_
+
@@ -25,6 +25,13 @@ simsignal_t LtePhyBase::averageCqiDlSignal_ = registerSignal("averageCqiDl");
 simsignal_t LtePhyBase::averageCqiUlSignal_ = registerSignal("averageCqiUl");
 simsignal_t LtePhyBase::averageCqiD2DSignal_ = registerSignal("averageCqiD2D");
 
+LtePhyBase::~LtePhyBase()
+{
+    for (auto frame : airFramePool_)
+        delete frame;
+    for (auto info : controlInfoPool_)
+        delete info;
+}
 
 void LtePhyBase::initialize(int stage)
 {
@@ -48,6 +55,15 @@ void LtePhyBase::initialize(int stage)
 
         multicastD2DRange_ = par("multicastD2DRange");
         enableMulticastD2DRangeCheck_ = par("enableMulticastD2DRangeCheck");
+
+        controlFramePool_ = par("controlFramePool");
+        controlFramePoolCapacity_ = par("controlFramePoolCapacity");
+        if (controlFramePool_) {
+            airFramePool_.reserve(controlFramePoolCapacity_);
+            controlInfoPool_.reserve(controlFramePoolCapacity_);
+            WATCH(numControlFramePoolHits_);
+            WATCH(numControlFramePoolMisses_);
+        }
     }
     else if (stage == INITSTAGE_SIMU5G_REGISTRATIONS2) {
         initializeChannelModel();
@@ -80,9 +96,9 @@ void LtePhyBase::handleControlMsg(LteAirFrame *frame,
         UserControlInfo *userInfo)
 {
     auto pkt = check_and_cast<inet::Packet *>(frame->decapsulate());
-    delete frame;
+    recycleAirFrame(frame);
     *(pkt->addTagIfAbsent<UserControlInfo>()) = *userInfo;
-    delete userInfo;
+    recycleControlInfo(userInfo);
     send(pkt, upperGateOut_);
 }
 
@@ -120,7 +136,7 @@ void LtePhyBase::handleUpperMessage(cMessage *msg)
         default: name = "airframe"; break;
     }
 
-    LteAirFrame *frame = new LteAirFrame(name);
+    LteAirFrame *frame = (lteInfo->getFrameType() == DATAPKT) ? new LteAirFrame(name) : acquireAirFrame(name);
 
     frame->encapsulate(check_and_cast<cPacket *>(msg));
 
@@ -138,7 +154,7 @@ void LtePhyBase::handleUpperMessage(cMessage *msg)
     // set current position
     lteInfo->setCoord(getRadioPosition());
     lteInfo->setTxPower(txPower_);
-    frame->setControlInfo(lteInfo.get()->dup());
+    frame->setControlInfo(acquireControlInfo(*lteInfo));
 
     EV << "LtePhy: " << nodeTypeToA(nodeType_) << " with id " << nodeId_
        << " sending message to the air channel. Dest=" << lteInfo->getDestId() << endl;
@@ -178,17 +194,20 @@ void LtePhyBase::updateDisplayString()
     getDisplayString().setTagArg("t", 0, buf);
 }
 
-void LtePhyBase::sendBroadcast(LteAirFrame *airFrame)
+void LtePhyBase::sendBroadcast(LteAirFrame *airFrame, const IChannelControl::ReceiverFilter& filter)
 {
     // Remove control info to allow parsim packing
     if (airFrame->getControlInfo() != nullptr) {
         UserControlInfo *userControlInfo = check_and_cast<UserControlInfo *>(airFrame->removeControlInfo());
         airFrame->setAdditionalInfo(*userControlInfo);
-        delete userControlInfo;
+        recycleControlInfo(userControlInfo);
     }
 
     // delegate the ChannelControl to send the airframe
-    sendToChannel(airFrame);
+    if (filter)
+        sendToChannel(airFrame, filter);
+    else
+        sendToChannel(airFrame);
 }
 
 LteAmc *LtePhyBase::getAmcModule(MacNodeId id)
@@ -215,7 +234,7 @@ void LtePhyBase::sendMulticast(LteAirFrame *frame)
 
     // transfer control info into airframe fields
     frame->setAdditionalInfo(*ci);
-    delete frame->removeControlInfo();
+    recycleControlInfo(check_and_cast<UserControlInfo *>(frame->removeControlInfo()));
 
     // send the frame to nodes belonging to the multicast group only
     for (auto [destId, nodeInfo] : binder_->getNodeInfoMap()) {
@@ -273,12 +292,88 @@ void LtePhyBase::sendUnicast(LteAirFrame *frame)
     if (frame->getControlInfo() != nullptr) {
         UserControlInfo *userControlInfo = check_and_cast<UserControlInfo *>(frame->removeControlInfo());
         frame->setAdditionalInfo(*userControlInfo);
-        delete userControlInfo;
+        recycleControlInfo(userControlInfo);
     }
 
     sendDirect(frame, 0, frame->getDuration(), receiver, getReceiverGateIndex(receiver, isNrUe(dest)));
 }
 
+LteAirFrame *LtePhyBase::acquireAirFrame(const char *name)
+{
+    if (!controlFramePool_)
+        return new LteAirFrame(name);
+
+    if (airFramePool_.empty()) {
+        numControlFramePoolMisses_++;
+        return new LteAirFrame(name);
+    }
+
+    numControlFramePoolHits_++;
+    LteAirFrame *frame = airFramePool_.back();
+    airFramePool_.pop_back();
+
+    // only the name, duration and scheduling priority of control frames are set by the senders
+    frame->setName(name);
+    frame->setDuration(0);
+    frame->setSchedulingPriority(0);
+    frame->setRemoteUnitPhyDataVectorArraySize(0);
+    return frame;
+}
+
+void LtePhyBase::recycleAirFrame(LteAirFrame *frame)
+{
+    if (!controlFramePool_ || airFramePool_.size() >= controlFramePoolCapacity_
+        || frame->getEncapsulatedPacket() != nullptr || frame->getControlInfo() != nullptr)
+    {
+        delete frame;
+        return;
+    }
+    airFramePool_.push_back(frame);
+}
+
+UserControlInfo *LtePhyBase::acquireControlInfo(const UserControlInfo& info)
+{
+    if (!controlFramePool_)
+        return info.dup();
+
+    if (controlInfoPool_.empty()) {
+        numControlFramePoolMisses_++;
+        return info.dup();
+    }
+
+    numControlFramePoolHits_++;
+    UserControlInfo *pooledInfo = controlInfoPool_.back();
+    controlInfoPool_.pop_back();
+    *pooledInfo = info;
+    return pooledInfo;
+}
+
+UserControlInfo *LtePhyBase::acquireControlInfo()
+{
+    if (!controlFramePool_)
+        return new UserControlInfo();
+
+    if (controlInfoPool_.empty()) {
+        numControlFramePoolMisses_++;
+        return new UserControlInfo();
+    }
+
+    numControlFramePoolHits_++;
+    UserControlInfo *pooledInfo = controlInfoPool_.back();
+    controlInfoPool_.pop_back();
+    *pooledInfo = UserControlInfo();
+    return pooledInfo;
+}
+
+void LtePhyBase::recycleControlInfo(UserControlInfo *info)
+{
+    if (!controlFramePool_ || controlInfoPool_.size() >= controlFramePoolCapacity_) {
+        delete info;
+        return;
+    }
+    controlInfoPool_.push_back(info);
+}
+
 int LtePhyBase::getReceiverGateIndex(const cModule *receiver, bool isNr) const
 {
     int gate = (isNr) ? receiver->findGate("nrRadioIn") : receiver->findGate("radioIn");
@@ -146,8 +146,22 @@ class LtePhyBase : public ChannelAccess
     // last time that the node has transmitted (currently, used only by UEs)
     simtime_t lastActive_;
 
+    /*
+     * Pool of control frames (H-ARQ feedback, grants, RAC, CQI feedback) and control infos.
+     * Frames and control infos are recycled by the PHY that consumes them and reused for
+     * the next control frame sent by the same PHY
+     */
+    bool controlFramePool_ = false;
+    unsigned int controlFramePoolCapacity_ = 0;
+    std::vector<LteAirFrame *> airFramePool_;
+    std::vector<UserControlInfo *> controlInfoPool_;
+    unsigned int numControlFramePoolHits_ = 0;
+    unsigned int numControlFramePoolMisses_ = 0;
+
   public:
 
+    ~LtePhyBase() override;
+
     const LteChannelModel *getPrimaryChannelModel()
     {
         return primaryChannelModel_;
@@ -222,8 +236,9 @@ class LtePhyBase : public ChannelAccess
      * Sends a frame to all NICs in range.
      *
      * Frames are sent with zero transmission delay.
+     * If a filter is given, the frame is only sent to the NICs accepted by it.
      */
-    virtual void sendBroadcast(LteAirFrame *airFrame);
+    virtual void sendBroadcast(LteAirFrame *airFrame, const IChannelControl::ReceiverFilter& filter = nullptr);
 
     /**
      * Sends a frame to the modules registered to the multicast group indicated in the frame
@@ -315,6 +330,34 @@ class LtePhyBase : public ChannelAccess
      */
     LteAirFrame *createHandoverMessage();
 
+    /**
+     * Returns an empty LteAirFrame for a control packet, taken from the
+     * control frame pool when possible.
+     */
+    LteAirFrame *acquireAirFrame(const char *name);
+
+    /**
+     * Returns a control frame that is no longer needed to the pool. The frame must
+     * not carry any packet. If the pool is disabled or full, the frame is deleted.
+     */
+    void recycleAirFrame(LteAirFrame *frame);
+
+    /**
+     * Returns a copy of the given control info, taken from the control info pool when possible.
+     */
+    UserControlInfo *acquireControlInfo(const UserControlInfo& info);
+
+    /**
+     * Returns a default-initialized control info, taken from the control info pool when possible.
+     */
+    UserControlInfo *acquireControlInfo();
+
+    /**
+     * Returns a control info that is no longer needed to the pool.
+     * If the pool is disabled or full, the control info is deleted.
+     */
+    void recycleControlInfo(UserControlInfo *info);
+
     /**
      * Returns the pointer to the AMC module, given a master ID (ENODEB)
      */
@@ -13,6 +13,7 @@
 #include <inet/networklayer/common/NetworkInterface.h>
 
 #include "simu5g/stack/phy/LtePhyEnb.h"
+#include "simu5g/stack/phy/LtePhyUe.h"
 #include "simu5g/stack/phy/packet/LteFeedbackPkt.h"
 #include "simu5g/common/LteCommon.h"
 #include "simu5g/common/LteControlInfoTags_m.h"
@@ -27,7 +28,20 @@ using namespace inet;
 
 LtePhyEnb::~LtePhyEnb()
 {
+    {
+        std::lock_guard<std::mutex> lock(decodingMutex_);
+        stopDecodingWorkers_ = true;
+    }
+    decodingStart_.notify_all();
+    for (auto& worker : decodingWorkers_)
+        worker.join();
+
     cancelAndDelete(bdcStarter_);
+    cancelAndDelete(batchDecodingTimer_);
+    for (unsigned int i = 0; i < numPendingReceptions_; i++) {
+        delete pendingReceptions_[i].lteInfo;
+        delete pendingReceptions_[i].frame;
+    }
     delete lteFeedbackComputation_;
 }
 
@@ -46,6 +60,21 @@ void LtePhyEnb::initialize(int stage)
 
         nodeType_ = NODEB;
         WATCH(nodeType_);
+
+        batchDecoding_ = par("batchDecoding");
+        int batchDecodingThreads = par("batchDecodingThreads");
+        if (batchDecodingThreads < 1)
+            throw cRuntimeError("LtePhyEnb::initialize - batchDecodingThreads must be at least 1");
+        batchDecodingThreads_ = batchDecodingThreads;
+        checkBatchDecoding_ = par("checkBatchDecoding");
+        if (batchDecoding_) {
+            batchDecodingTimer_ = new cMessage("batchDecodingTimer");
+            batchDecodingTimer_->setSchedulingPriority(10);  // after all the frames received in this TTI
+
+            // the workers are kept for the whole simulation, as the batches are too small to amortize the creation of threads
+            for (unsigned int t = 1; t < batchDecodingThreads_; t++)
+                decodingWorkers_.emplace_back(&LtePhyEnb::decodingWorkerLoop, this, t);
+        }
     }
     else if (stage == INITSTAGE_SIMU5G_BINDER_ACCESS) {
         cellInfo_ = binder_->getCellInfoByNodeId(nodeId_);
@@ -84,9 +113,16 @@ void LtePhyEnb::handleSelfMessage(cMessage *msg)
     if (msg->isName("bdcStarter")) {
         // send broadcast message
         LteAirFrame *f = createHandoverMessage();
-        sendBroadcast(f);
+        // UEs that pruned this cell from their handover candidates do not receive the broadcast
+        sendBroadcast(f, [this](cModule *radioModule) {
+            LtePhyUe *uePhy = dynamic_cast<LtePhyUe *>(radioModule);
+            return uePhy == nullptr || uePhy->isHandoverCandidate(nodeId_);
+        });
         scheduleAt(NOW + bdcUpdateInterval_, msg);
     }
+    else if (msg == batchDecodingTimer_) {
+        decodeBatch();
+    }
     else {
         delete msg;
     }
@@ -116,7 +152,7 @@ bool LtePhyEnb::handleControlPkt(UserControlInfo *lteinfo, LteAirFrame *frame)
     //handle feedback packet
     if (lteinfo->getFrameType() == FEEDBACKPKT) {
         handleFeedbackPkt(lteinfo, frame);
-        delete frame;
+        recycleAirFrame(frame);
         return true;
     }
     return false;
@@ -125,7 +161,7 @@ bool LtePhyEnb::handleControlPkt(UserControlInfo *lteinfo, LteAirFrame *frame)
 void LtePhyEnb::handleAirFrame(cMessage *msg)
 {
     LteAirFrame *frame = static_cast<LteAirFrame *>(msg);
-    UserControlInfo *lteInfo = new UserControlInfo(frame->getAdditionalInfo());
+    UserControlInfo *lteInfo = acquireControlInfo(frame->getAdditionalInfo());
 
     EV << "LtePhy: received new LteAirFrame with ID " << frame->getId() << " from channel" << endl;
 
@@ -176,8 +212,123 @@ void LtePhyEnb::handleAirFrame(cMessage *msg)
     if (handleControlPkt(lteInfo, frame))
         return; // If frame contains a control packet no further action is needed
 
+    decodeAirFrame(frame, lteInfo, channelModel);
+}
+
+void LtePhyEnb::decodeAirFrame(LteAirFrame *frame, UserControlInfo *lteInfo, LteChannelModel *channelModel)
+{
+    if (batchDecoding_) {
+        // store the frame, it will be decoded along with the other frames received in this TTI
+        if (numPendingReceptions_ == pendingReceptions_.size())
+            pendingReceptions_.emplace_back();
+        LteChannelModel::ReceptionEvaluation& reception = pendingReceptions_[numPendingReceptions_++];
+        reception.frame = frame;
+        reception.lteInfo = lteInfo;
+        reception.channelModel = channelModel;
+
+        // the computation of the SINR modifies the state of the channel model and extracts
+        // random numbers, hence it is performed on reception, as in the non-batch case
+        channelModel->prepareReception(reception);
+
+        if (!batchDecodingTimer_->isScheduled())
+            scheduleAt(NOW, batchDecodingTimer_);
+        return;
+    }
+
     // DAS removed - single antenna only
     bool result = channelModel->isReceptionSuccessful(frame, lteInfo);
+    deliverAirFrame(frame, lteInfo, result);
+}
+
+void LtePhyEnb::decodeBatch()
+{
+    EV << NOW << " LtePhyEnb::decodeBatch - decoding " << numPendingReceptions_ << " frames" << endl;
+
+    // keep a copy of the prepared receptions, to be evaluated serially after the batch
+    std::vector<LteChannelModel::ReceptionEvaluation> serialReceptions;
+    if (checkBatchDecoding_)
+        serialReceptions.assign(pendingReceptions_.begin(), pendingReceptions_.begin() + numPendingReceptions_);
+
+    // the error probabilities are independent of each other
+    unsigned int numThreads = std::min(batchDecodingThreads_, numPendingReceptions_);
+    if (numThreads > 1) {
+        {
+            std::lock_guard<std::mutex> lock(decodingMutex_);
+            numDecodingThreads_ = numThreads;
+            numBusyWorkers_ = numThreads - 1;
+            decodingRound_++;
+        }
+        decodingStart_.notify_all();
+        evaluatePendingReceptions(0, numThreads);
+
+        std::unique_lock<std::mutex> lock(decodingMutex_);
+        decodingDone_.wait(lock, [this] { return numBusyWorkers_ == 0; });
+    }
+    else {
+        evaluatePendingReceptions(0, 1);
+    }
+
+    if (checkBatchDecoding_)
+        checkBatchEvaluation(serialReceptions);
+
+    // statistics and delivery, in order of reception
+    unsigned int numReceptions = numPendingReceptions_;
+    numPendingReceptions_ = 0;
+    for (unsigned int i = 0; i < numReceptions; i++) {
+        LteChannelModel::ReceptionEvaluation& reception = pendingReceptions_[i];
+        bool result = reception.channelModel->completeReception(reception);
+        deliverAirFrame(reception.frame, reception.lteInfo, result);
+        reception.frame = nullptr;
+        reception.lteInfo = nullptr;
+    }
+}
+
+void LtePhyEnb::evaluatePendingReceptions(unsigned int first, unsigned int stride)
+{
+    for (unsigned int i = first; i < numPendingReceptions_; i += stride)
+        pendingReceptions_[i].channelModel->evaluateReception(pendingReceptions_[i]);
+}
+
+void LtePhyEnb::checkBatchEvaluation(std::vector<LteChannelModel::ReceptionEvaluation>& serialReceptions)
+{
+    for (unsigned int i = 0; i < serialReceptions.size(); i++) {
+        LteChannelModel::ReceptionEvaluation& serial = serialReceptions[i];
+        serial.channelModel->evaluateReception(serial);
+
+        const LteChannelModel::ReceptionEvaluation& batch = pendingReceptions_[i];
+        if (batch.decided != serial.decided || batch.result != serial.result
+            || batch.packetErrorRate != serial.packetErrorRate || batch.errorRate != serial.errorRate)
+            throw cRuntimeError("LtePhyEnb::checkBatchEvaluation - frame %u from node %hu: the parallel evaluation (per=%g, errorRate=%g) differs from the serial one (per=%g, errorRate=%g)",
+                    i, num(batch.lteInfo->getSourceId()), batch.packetErrorRate, batch.errorRate, serial.packetErrorRate, serial.errorRate);
+    }
+}
+
+void LtePhyEnb::decodingWorkerLoop(unsigned int index)
+{
+    unsigned long round = 0;
+    std::unique_lock<std::mutex> lock(decodingMutex_);
+    while (true) {
+        decodingStart_.wait(lock, [this, round] { return stopDecodingWorkers_ || decodingRound_ != round; });
+        if (stopDecodingWorkers_)
+            return;
+
+        round = decodingRound_;
+        unsigned int numThreads = numDecodingThreads_;
+        // small batches do not need all the workers
+        if (index >= numThreads)
+            continue;
+
+        lock.unlock();
+        evaluatePendingReceptions(index, numThreads);
+        lock.lock();
+
+        if (--numBusyWorkers_ == 0)
+            decodingDone_.notify_one();
+    }
+}
+
+void LtePhyEnb::deliverAirFrame(LteAirFrame *frame, UserControlInfo *lteInfo, bool result)
+{
     if (result)
         numAirFrameReceived_++;
     else
@@ -216,13 +367,13 @@ void LtePhyEnb::requestFeedback(UserControlInfo *lteinfo, LteAirFrame *frame, Pa
     Coord sendersPos = lteinfo->getCoord();
     cellInfo_->setUePosition(lteinfo->getSourceId(), sendersPos);
 
-    std::vector<double> snr;
+    std::vector<double>& snr = feedbackSinrBuffer_;
     auto header = pktAux->removeAtFront<LteFeedbackPkt>();
 
     //Apply analog model (path loss)
     //Get snr for UL direction
     if (channelModel != nullptr)
-        snr = channelModel->getSINR(frame, lteinfo);
+        channelModel->getFeedbackSINR(frame, lteinfo, snr);
     else
         throw cRuntimeError("LtePhyEnbD2D::requestFeedback - channelModel is a null pointer");
 
@@ -254,7 +405,7 @@ void LtePhyEnb::requestFeedback(UserControlInfo *lteinfo, LteAirFrame *frame, Pa
 
             //Get snr for DL direction
             if (channelModel != nullptr)
-                snr = channelModel->getSINR(frame, lteinfo);
+                channelModel->getFeedbackSINR(frame, lteinfo, snr);
             else
                 throw cRuntimeError("LtePhyEnbD2D::requestFeedback - channelModel is a null pointer");
         }
@@ -311,7 +462,7 @@ void LtePhyEnb::handleFeedbackPkt(UserControlInfo *lteinfo,
             }
         }
     }
-    delete lteinfo;
+    recycleControlInfo(lteinfo);
     // send decapsulated message along with result control info to upperGateOut_
     send(pktAux, upperGateOut_);
 }
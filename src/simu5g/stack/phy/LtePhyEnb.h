@@ -13,6 +13,10 @@
 #ifndef _LTE_AIRPHYENB_H_
 #define _LTE_AIRPHYENB_H_
 
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 #include "simu5g/stack/phy/LtePhyBase.h"
 
 namespace simu5g {
@@ -33,12 +37,61 @@ class LtePhyEnb : public LtePhyBase
 
     int randomChannelIndex_;
 
+    /** SINR vector used for feedback computation, reused across feedback requests */
+    std::vector<double> feedbackSinrBuffer_;
+
+    /*
+     * Batch decoding: data frames received in a TTI are decoded together at the end of the TTI,
+     * and the error probability of the frames is computed by batchDecodingThreads_ threads
+     */
+    bool batchDecoding_ = false;
+    unsigned int batchDecodingThreads_ = 1;
+
+    /** If true, each batch is evaluated serially too, and the results are compared (test only) */
+    bool checkBatchDecoding_ = false;
+
+    /** Self-message triggering the decoding of the pending frames */
+    cMessage *batchDecodingTimer_ = nullptr;
+
+    /** Frames waiting for decoding (only the first numPendingReceptions_ entries are valid) */
+    std::vector<LteChannelModel::ReceptionEvaluation> pendingReceptions_;
+    unsigned int numPendingReceptions_ = 0;
+
+    /*
+     * Worker threads of batch decoding, created in initialize() and joined in the destructor.
+     * The simulation thread evaluates its share of the frames too, hence there are
+     * batchDecodingThreads_ - 1 workers. Worker t evaluates the frames t, t + n, t + 2n, ...
+     * where n is the number of threads used for the current batch
+     */
+    std::vector<std::thread> decodingWorkers_;
+    std::mutex decodingMutex_;
+    std::condition_variable decodingStart_;
+    std::condition_variable decodingDone_;
+    unsigned long decodingRound_ = 0;        // incremented to wake up the workers for a new batch
+    unsigned int numDecodingThreads_ = 0;    // threads used for the current batch
+    unsigned int numBusyWorkers_ = 0;        // workers that have not completed the current batch yet
+    bool stopDecodingWorkers_ = false;
+
     void initialize(int stage) override;
 
     void handleSelfMessage(cMessage *msg) override;
     void handleAirFrame(cMessage *msg) override;
     bool handleControlPkt(UserControlInfo *lteinfo, LteAirFrame *frame);
     void handleFeedbackPkt(UserControlInfo *lteinfo, LteAirFrame *frame);
+
+    /*
+     * Decodes a data frame, either immediately or at the end of the TTI if batch decoding is enabled
+     */
+    void decodeAirFrame(LteAirFrame *frame, UserControlInfo *lteInfo, LteChannelModel *channelModel);
+    void decodeBatch();
+    void evaluatePendingReceptions(unsigned int first, unsigned int stride);
+    void checkBatchEvaluation(std::vector<LteChannelModel::ReceptionEvaluation>& serialReceptions);
+    void decodingWorkerLoop(unsigned int index);
+
+    /*
+     * Sends the packet carried by the frame to the upper layer, along with the decoding result
+     */
+    void deliverAirFrame(LteAirFrame *frame, UserControlInfo *lteInfo, bool result);
     virtual void requestFeedback(UserControlInfo *lteinfo, LteAirFrame *frame, inet::Packet *pkt);
     // Feedback computation for PisaPhy
     LteFeedbackComputation *getFeedbackComputationFromName(std::string name, ParameterMap& params);
@@ -47,9 +47,9 @@ void LtePhyEnbD2D::requestFeedback(UserControlInfo *lteinfo, LteAirFrame *frame,
 
     // Apply analog model (pathloss)
     // Get SNR for UL direction
-    std::vector<double> snr;
+    std::vector<double>& snr = feedbackSinrBuffer_;
     if (channelModel != nullptr)
-        snr = channelModel->getSINR(frame, lteinfo);
+        channelModel->getFeedbackSINR(frame, lteinfo, snr);
     else
         throw cRuntimeError("LtePhyEnbD2D::requestFeedback - channelModel is null pointer");
     FeedbackRequest req = lteinfo->getFeedbackReq();
@@ -76,7 +76,7 @@ void LtePhyEnbD2D::requestFeedback(UserControlInfo *lteinfo, LteAirFrame *frame,
             lteinfo->setDirection(DL);
             // Get SNR for DL direction
             if (channelModel != nullptr)
-                snr = channelModel->getSINR(frame, lteinfo);
+                channelModel->getFeedbackSINR(frame, lteinfo, snr);
             else
                 throw cRuntimeError("LtePhyEnbD2D::requestFeedback - channelModel is null pointer");
 
@@ -97,7 +97,7 @@ void LtePhyEnbD2D::requestFeedback(UserControlInfo *lteinfo, LteAirFrame *frame,
 
                         // Get SINR for this link
                         if (channelModel != nullptr)
-                            snr = channelModel->getSINR_D2D(frame, lteinfo, peerId, peerCoord, nodeId_);
+                            channelModel->getSINR_D2D(frame, lteinfo, peerId, peerCoord, nodeId_, snr);
                         else
                             throw cRuntimeError("LtePhyEnbD2D::requestFeedback - channelModel is null pointer");
 
@@ -123,7 +123,7 @@ void LtePhyEnbD2D::requestFeedback(UserControlInfo *lteinfo, LteAirFrame *frame,
 void LtePhyEnbD2D::handleAirFrame(cMessage *msg)
 {
     LteAirFrame *frame = static_cast<LteAirFrame *>(msg);
-    UserControlInfo *lteInfo = new UserControlInfo(frame->getAdditionalInfo());
+    UserControlInfo *lteInfo = acquireControlInfo(frame->getAdditionalInfo());
 
     EV << "LtePhyEnbD2D::handleAirFrame - received new LteAirFrame with ID " << frame->getId() << " from channel" << endl;
 
@@ -195,33 +195,7 @@ void LtePhyEnbD2D::handleAirFrame(cMessage *msg)
     if (handleControlPkt(lteInfo, frame))
         return; // If frame contains a control pkt no further action is needed
 
-    // DAS removed - single antenna only
-    bool result = channelModel->isReceptionSuccessful(frame, lteInfo);
-    if (result)
-        numAirFrameReceived_++;
-    else
-        numAirFrameNotReceived_++;
-
-    EV << "Handled LteAirframe with ID " << frame->getId() << " with result "
-       << (result ? "RECEIVED" : "NOT RECEIVED") << endl;
-
-    auto pkt = check_and_cast<inet::Packet *>(frame->decapsulate());
-
-    // Here frame has to be destroyed since it is no longer useful
-    delete frame;
-
-    // Attach the decider result to the packet as control info
-    auto lteInfoTag = pkt->addTagIfAbsent<UserControlInfo>();
-    *lteInfoTag = *lteInfo;
-    delete lteInfo;
-
-    pkt->addTagIfAbsent<PhyReceptionInd>()->setDeciderResult(result);
-
-    // Send decapsulated message along with result control info to upperGateOut_
-    send(pkt, upperGateOut_);
-
-    if (getEnvir()->isGUI())
-        updateDisplayString();
+    decodeAirFrame(frame, lteInfo, channelModel);
 }
 
 } //namespace
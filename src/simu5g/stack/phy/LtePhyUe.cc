@@ -50,6 +50,8 @@ void LtePhyUe::initialize(int stage)
             minRssi_ = binder_->phyPisaData.minSnr();
         else
             minRssi_ = par("minRssi").doubleValue();
+        handoverPruningMargin_ = par("handoverPruningMargin").doubleValue();
+        handoverPruningDistance_ = par("handoverPruningDistance").doubleValue();
 
         currentMasterRssi_ = -999.0;
         candidateMasterRssi_ = -999.0;
@@ -129,11 +131,10 @@ void LtePhyUe::initialize(int stage)
 
 void LtePhyUe::findCandidateEnb(MacNodeId& outCandidateMasterId, double& outCandidateMasterRssi)
 {
-    // this is a fictitious frame that needs to compute the SINR
-    LteAirFrame *frame = new LteAirFrame("cellSelectionFrame");
-    UserControlInfo *cInfo = new UserControlInfo();
     outCandidateMasterId = NODEID_NONE;
 
+    GHz ueCarrierFrequency = primaryChannelModel_->getCarrierFrequency();
+
     // get the list of all eNodeBs in the network
     for (const auto &enbInfo : binder_->getEnbList()) {
         // the NR phy layer only checks signal from gNBs, and
@@ -147,31 +148,19 @@ void LtePhyUe::findCandidateEnb(MacNodeId& outCandidateMasterId, double& outCand
         double cellTxPower = cellPhy->getTxPwr();
         Coord cellPos = cellPhy->getCoord();
         // check whether the BS supports the carrier frequency used by the UE
-        GHz ueCarrierFrequency = primaryChannelModel_->getCarrierFrequency();
         LteChannelModel *cellChannelModel = cellPhy->getChannelModel(ueCarrierFrequency);
         if (cellChannelModel == nullptr)
             continue;
 
-        // build a control info
-        cInfo->setSourceId(cellId);
-        cInfo->setTxPower(cellTxPower);
-        cInfo->setCoord(cellPos);
-        cInfo->setFrameType(BROADCASTPKT);
-        cInfo->setDirection(DL);
-        // get RSSI from the BS
-        double rssi = 0;
-        std::vector<double> rssiV = primaryChannelModel_->getRSRP(frame, cInfo);
-        for (auto value : rssiV)
-            rssi += value;
-        rssi /= rssiV.size(); // compute the mean over all RBs
+        // get RSSI from the BS. The UE is not attached yet, hence the signal is
+        // not measured on behalf of a specific destination
+        double rssi = primaryChannelModel_->queryRsrp(cellId, cellTxPower, cellPos, NODEID_NONE, ueCarrierFrequency);
         EV << "LtePhyUe::findCandicateEnb - RSSI from cell " << cellId << ": " << rssi << " dB (current candidate cell " << outCandidateMasterId << ": " << outCandidateMasterRssi << " dB)" << endl;
         if (outCandidateMasterId == NODEID_NONE || rssi > outCandidateMasterRssi) {
             outCandidateMasterId = cellId;
             outCandidateMasterRssi = rssi;
         }
     }
-    delete cInfo;
-    delete frame;
 }
 
 void LtePhyUe::handleSelfMessage(cMessage *msg)
@@ -198,13 +187,13 @@ void LtePhyUe::handoverHandler(LteAirFrame *frame, UserControlInfo *lteInfo)
     double rssi = 0;
 
     // Compute RSSI from broadcast message (DAS removed - single antenna)
-    std::vector<double> rssiV = primaryChannelModel_->getSINR(frame, lteInfo);
-    for (auto value : rssiV)
-        rssi += value;
-    rssi /= rssiV.size();
+    rssi = primaryChannelModel_->getWidebandSINR(frame, lteInfo);
 
     EV << "UE " << nodeId_ << " broadcast frame from " << lteInfo->getSourceId() << " with RSSI: " << rssi << " at " << simTime() << endl;
 
+    if (handoverPruningMargin_ >= 0)
+        handoverMeasurements_[lteInfo->getSourceId()] = {rssi, getCoord()};
+
     if (lteInfo->getSourceId() != masterId_ && rssi < minRssi_) {
         EV << "Signal too weak from a candidate master - minRssi[" << minRssi_ << "]" << endl;
         delete frame;
@@ -268,6 +257,24 @@ void LtePhyUe::handoverHandler(LteAirFrame *frame, UserControlInfo *lteInfo)
     delete frame;
 }
 
+bool LtePhyUe::isHandoverCandidate(MacNodeId cellId) const
+{
+    if (handoverPruningMargin_ < 0 || cellId == masterId_ || cellId == candidateMasterId_)
+        return true;
+
+    auto it = handoverMeasurements_.find(cellId);
+    if (it == handoverMeasurements_.end())
+        return true;
+
+    // measure the cell again once the UE has moved far enough from where the last measurement was taken
+    const HandoverMeasurement& measurement = it->second;
+    if (getRadioPosition().distance(measurement.position) >= handoverPruningDistance_)
+        return true;
+
+    // the cell could not become the handover target within the margin
+    return measurement.rssi + handoverPruningMargin_ >= candidateMasterRssi_ + hysteresisTh_;
+}
+
 void LtePhyUe::triggerHandover()
 {
     ASSERT(masterId_ != candidateMasterId_);
@@ -397,7 +404,7 @@ void LtePhyUe::doHandover()
 void LtePhyUe::handleAirFrame(cMessage *msg)
 {
     LteAirFrame *frame = static_cast<LteAirFrame *>(msg);
-    UserControlInfo *lteInfo = new UserControlInfo(frame->getAdditionalInfo());
+    UserControlInfo *lteInfo = acquireControlInfo(frame->getAdditionalInfo());
 
     connectedNodeId_ = masterId_;
     EV << "LtePhy: received new LteAirFrame with ID " << frame->getId() << " from channel" << endl;
@@ -602,42 +609,37 @@ void LtePhyUe::sendFeedback(LteFeedbackDoubleVector fbDl, LteFeedbackDoubleVecto
     auto pkt = new Packet("feedback_pkt");
     pkt->insertAtFront(fbPkt);
 
-    UserControlInfo *uinfo = new UserControlInfo();
-    uinfo->setSourceId(nodeId_);
-    uinfo->setDestId(masterId_);
-    uinfo->setFrameType(FEEDBACKPKT);
-    // create LteAirFrame and encapsulate a feedback packet
-    LteAirFrame *frame = new LteAirFrame("feedback_pkt");
-    frame->encapsulate(check_and_cast<cPacket *>(pkt));
-    uinfo->setFeedbackReq(req);
-    uinfo->setDirection(UL);
-    simtime_t signalLength = TTI;
-    uinfo->setTxPower(txPower_);
-    // initialize frame fields
-
-    frame->setSchedulingPriority(airFramePriority_);
-    frame->setDuration(signalLength);
-
-    uinfo->setCoord(getRadioPosition());
-
-    //TODO access speed data Update channel index
     lastFeedback_ = NOW;
 
-    // send one feedback packet for each carrier
+    // send one feedback packet for each carrier. Frames and control infos are filled in place,
+    // so that they can be taken from the control frame pool
+    unsigned int remainingCarriers = channelModel_.size();
     for (auto& cm : channelModel_) {
         GHz carrierFrequency = cm.first;
-        LteAirFrame *carrierFrame = frame->dup();
-        UserControlInfo *carrierInfo = uinfo->dup();
+
+        UserControlInfo *carrierInfo = acquireControlInfo();
+        carrierInfo->setSourceId(nodeId_);
+        carrierInfo->setDestId(masterId_);
+        carrierInfo->setFrameType(FEEDBACKPKT);
+        carrierInfo->setFeedbackReq(req);
+        carrierInfo->setDirection(UL);
+        carrierInfo->setTxPower(txPower_);
+        carrierInfo->setCoord(getRadioPosition());
         carrierInfo->setCarrierFrequency(carrierFrequency);
+
+        LteAirFrame *carrierFrame = acquireAirFrame("feedback_pkt");
+        // the last carrier takes the feedback packet, the other ones a copy of it
+        carrierFrame->encapsulate(--remainingCarriers > 0 ? pkt->dup() : pkt);
+        carrierFrame->setSchedulingPriority(airFramePriority_);
+        carrierFrame->setDuration(TTI);
         carrierFrame->setControlInfo(carrierInfo);
 
         EV << "LtePhy: " << nodeTypeToA(nodeType_) << " with id "
            << nodeId_ << " sending feedback to the air channel for carrier " << carrierFrequency << endl;
         sendUnicast(carrierFrame);
     }
-
-    delete frame;
-    delete uinfo;
+    if (channelModel_.empty())
+        delete pkt;
 }
 
 void LtePhyUe::recordCqi(unsigned int sample, Direction dir)
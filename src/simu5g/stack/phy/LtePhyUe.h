@@ -90,6 +90,19 @@ class LtePhyUe : public LtePhyBase
     // Lower threshold of RSSI for detachment
     double minRssi_;
 
+    /*
+     * Handover candidate pruning (disabled if handoverPruningMargin_ < 0)
+     */
+    struct HandoverMeasurement
+    {
+        double rssi;          // last wideband RSSI measured from the cell
+        inet::Coord position; // position of the UE when the measurement was taken
+    };
+    // last measurement for each cell the UE received a handover broadcast from
+    std::map<MacNodeId, HandoverMeasurement> handoverMeasurements_;
+    double handoverPruningMargin_;
+    double handoverPruningDistance_;
+
     /**
      * Handover switch
      */
@@ -149,6 +162,12 @@ class LtePhyUe : public LtePhyBase
         return masterId_;
     }
 
+    /**
+     * Returns false if the given cell has been pruned from the handover candidates of this UE,
+     * i.e., its handover broadcasts do not need to be delivered
+     */
+    bool isHandoverCandidate(MacNodeId cellId) const;
+
     simtime_t coherenceTime(double speed)
     {
         double fd = (speed / SPEED_OF_LIGHT) * carrierFrequency_;
@@ -68,7 +68,7 @@ void LtePhyUeD2D::handleSelfMessage(cMessage *msg)
 void LtePhyUeD2D::handleAirFrame(cMessage *msg)
 {
     LteAirFrame *frame = static_cast<LteAirFrame *>(msg);
-    UserControlInfo *lteInfo = new UserControlInfo(frame->getAdditionalInfo());
+    UserControlInfo *lteInfo = acquireControlInfo(frame->getAdditionalInfo());
 
     connectedNodeId_ = masterId_;
     EV << "LtePhyUeD2D: received new LteAirFrame with ID " << frame->getId() << " from channel" << endl;
@@ -290,7 +290,7 @@ void LtePhyUeD2D::handleUpperMessage(cMessage *msg)
     LteAirFrame *frame = nullptr;
 
     if (lteInfo->getFrameType() == HARQPKT || lteInfo->getFrameType() == GRANTPKT || lteInfo->getFrameType() == RACPKT) {
-        frame = new LteAirFrame("harqFeedback-grant");
+        frame = acquireAirFrame("harqFeedback-grant");
     }
     else {
         // Create LteAirFrame and encapsulate the received packet.
@@ -313,7 +313,7 @@ void LtePhyUeD2D::handleUpperMessage(cMessage *msg)
 
     lteInfo->setTxPower(txPower_);
     lteInfo->setD2dTxPower(d2dTxPower_);
-    frame->setControlInfo(lteInfo.get()->dup());
+    frame->setControlInfo(acquireControlInfo(*lteInfo));
 
     EV << "LtePhyUeD2D::handleUpperMessage - " << nodeTypeToA(nodeType_) << " with id " << nodeId_
        << " sending message to the air channel. Dest=" << lteInfo->getDestId() << endl;
@@ -479,42 +479,38 @@ void LtePhyUeD2D::sendFeedback(LteFeedbackDoubleVector fbDl, LteFeedbackDoubleVe
     auto pkt = new Packet("feedback_pkt");
     pkt->insertAtFront(fbPkt);
 
-    UserControlInfo *uinfo = new UserControlInfo();
-    uinfo->setSourceId(nodeId_);
-    uinfo->setDestId(masterId_);
-    uinfo->setFrameType(FEEDBACKPKT);
-    // Create LteAirFrame and encapsulate a feedback packet
-    LteAirFrame *frame = new LteAirFrame("feedback_pkt");
-    frame->encapsulate(check_and_cast<cPacket *>(pkt));
-    uinfo->setFeedbackReq(req);
-    uinfo->setDirection(UL);
-    simtime_t signalLength = TTI;
-    uinfo->setTxPower(txPower_);
-    uinfo->setD2dTxPower(d2dTxPower_);
-    // Initialize frame fields
-
-    frame->setSchedulingPriority(airFramePriority_);
-    frame->setDuration(signalLength);
-
-    uinfo->setCoord(getRadioPosition());
-
     lastFeedback_ = NOW;
 
-    // Send one feedback packet for each carrier
+    // send one feedback packet for each carrier. Frames and control infos are filled in place,
+    // so that they can be taken from the control frame pool
+    unsigned int remainingCarriers = channelModel_.size();
     for (auto& cm : channelModel_) {
         GHz carrierFrequency = cm.first;
-        LteAirFrame *carrierFrame = frame->dup();
-        UserControlInfo *carrierInfo = uinfo->dup();
+
+        UserControlInfo *carrierInfo = acquireControlInfo();
+        carrierInfo->setSourceId(nodeId_);
+        carrierInfo->setDestId(masterId_);
+        carrierInfo->setFrameType(FEEDBACKPKT);
+        carrierInfo->setFeedbackReq(req);
+        carrierInfo->setDirection(UL);
+        carrierInfo->setTxPower(txPower_);
+        carrierInfo->setD2dTxPower(d2dTxPower_);
+        carrierInfo->setCoord(getRadioPosition());
         carrierInfo->setCarrierFrequency(carrierFrequency);
+
+        LteAirFrame *carrierFrame = acquireAirFrame("feedback_pkt");
+        // the last carrier takes the feedback packet, the other ones a copy of it
+        carrierFrame->encapsulate(--remainingCarriers > 0 ? pkt->dup() : pkt);
+        carrierFrame->setSchedulingPriority(airFramePriority_);
+        carrierFrame->setDuration(TTI);
         carrierFrame->setControlInfo(carrierInfo);
 
         EV << "LtePhy: " << nodeTypeToA(nodeType_) << " with id "
            << nodeId_ << " sending feedback to the air channel for carrier " << carrierFrequency << endl;
         sendUnicast(carrierFrame);
     }
-
-    delete frame;
-    delete uinfo;
+    if (channelModel_.empty())
+        delete pkt;
 }
 
 void LtePhyUeD2D::finish()
@@ -34,7 +34,7 @@ void NrPhyUe::initialize(int stage)
 void NrPhyUe::handleAirFrame(cMessage *msg)
 {
     LteAirFrame *frame = static_cast<LteAirFrame *>(msg);
-    UserControlInfo *lteInfo = new UserControlInfo(frame->getAdditionalInfo());
+    UserControlInfo *lteInfo = acquireControlInfo(frame->getAdditionalInfo());
 
     connectedNodeId_ = masterId_;
     EV << "NrPhyUe: received new LteAirFrame with ID " << frame->getId() << " from channel" << endl;
@@ -43,6 +43,15 @@ std::vector<double> LteChannelModel::getSINR(LteAirFrame *frame, UserControlInfo
     return tmp;
 }
 
+double LteChannelModel::getWidebandSINR(LteAirFrame *frame, UserControlInfo *lteInfo)
+{
+    std::vector<double> snrV = getSINR(frame, lteInfo);
+    double sum = 0.0;
+    for (auto value : snrV)
+        sum += value;
+    return sum / snrV.size();
+}
+
 std::vector<double> LteChannelModel::getRSRP(LteAirFrame *frame, UserControlInfo *lteInfo)
 {
     static const std::vector<double> tmp { 10000.0 };
@@ -73,6 +82,28 @@ std::vector<double> LteChannelModel::getSIR(LteAirFrame *frame, UserControlInfo
     return tmp;
 }
 
+double LteChannelModel::queryRsrp(MacNodeId txNode, double txPower, const inet::Coord& txCoord, MacNodeId rxNode, GHz carrierFrequency)
+{
+    // build a control info on the stack describing the transmission
+    UserControlInfo lteInfo;
+    lteInfo.setSourceId(txNode);
+    lteInfo.setDestId(rxNode);
+    lteInfo.setTxPower(txPower);
+    lteInfo.setCoord(txCoord);
+    lteInfo.setCarrierFrequency(carrierFrequency);
+    lteInfo.setFrameType(BROADCASTPKT);
+    lteInfo.setDirection(DL);
+
+    std::vector<double> rsrpVector;
+    getRSRP(nullptr, &lteInfo, rsrpVector);
+
+    // compute the mean over all RBs
+    double rsrp = 0;
+    for (auto value : rsrpVector)
+        rsrp += value;
+    return rsrp / rsrpVector.size();
+}
+
 bool LteChannelModel::isReceptionSuccessful_D2D(LteAirFrame *frame, UserControlInfo *lteInfo, const std::vector<double>& rsrpVector)
 {
     return true;
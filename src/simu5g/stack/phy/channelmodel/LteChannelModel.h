@@ -28,9 +28,42 @@ using namespace omnetpp;
 class LteAirFrame;
 class LtePhyBase;
 class Binder;
+class PhyPisaData;
 
 class LteChannelModel : public cSimpleModule
 {
+  public:
+    /*
+     * State of the decoding of a received frame, when the decoding is split into the
+     * stages prepareReception(), evaluateReception() and completeReception()
+     */
+    struct ReceptionEvaluation
+    {
+        LteAirFrame *frame = nullptr;
+        UserControlInfo *lteInfo = nullptr;
+        LteChannelModel *channelModel = nullptr;
+
+        // SINR of each band and bands used by the frame
+        std::vector<double> sinr;
+        RbMap rbmap;
+        Cqi cqi = 0;
+        unsigned int txModeIndex = 0;
+        unsigned char transmissionAttempt = 1;
+        PhyPisaData *phyPisaData = nullptr;
+
+        // true if the frame is lost regardless of the random sample (or if the outcome is already known)
+        bool decided = false;
+        bool result = false;
+
+        double randomSample = 0.0;
+        double packetErrorRate = 0.0;
+        double errorRate = 0.0;    // with H-ARQ error reduction
+
+        // for statistical purposes
+        double sumSnr = 0.0;
+        int usedRBs = 0;
+    };
+
   protected:
     // Reference to Binder module
     inet::ModuleRefByPar<Binder> binder_;
@@ -84,6 +117,27 @@ class LteChannelModel : public cSimpleModule
      */
     virtual bool isReceptionSuccessful(LteAirFrame *frame, UserControlInfo *lteInfo) = 0;
 
+    /*
+     * Same as isReceptionSuccessful(), split into three stages so that the frames received
+     * in the same TTI can be decoded in a batch:
+     * - prepareReception() computes the SINR and extracts the random sample. It modifies the
+     *   state of the channel model, hence it must be called in the order of reception
+     * - evaluateReception() computes the error probability. It only reads the state of the
+     *   evaluation, hence it can be called concurrently on different evaluations
+     * - completeReception() records the statistics and returns the outcome of the reception
+     *
+     * The default implementation decides the outcome in prepareReception()
+     *
+     * @param reception the frame and control info to be evaluated, and the evaluation state
+     */
+    virtual void prepareReception(ReceptionEvaluation& reception)
+    {
+        reception.decided = true;
+        reception.result = isReceptionSuccessful(reception.frame, reception.lteInfo);
+    }
+    virtual void evaluateReception(ReceptionEvaluation& reception) const {}
+    virtual bool completeReception(ReceptionEvaluation& reception) { return reception.result; }
+
     /*
      * Compute Attenuation caused by path loss and shadowing (optional)
      *
@@ -106,6 +160,11 @@ class LteChannelModel : public cSimpleModule
      * @param lteInfo pointer to the user control info
      */
     virtual std::vector<double> getSIR(LteAirFrame *frame, UserControlInfo *lteInfo) = 0;
+    /*
+     * Same as above, but the SIR is written into the caller-owned vector snrVector,
+     * whose storage is reused across calls
+     */
+    virtual void getSIR(LteAirFrame *frame, UserControlInfo *lteInfo, std::vector<double>& snrVector) { snrVector = getSIR(frame, lteInfo); }
     /*
      * Compute SINR for each band for user nodeId according to path loss, shadowing (optional), and multipath fading
      *
@@ -113,6 +172,23 @@ class LteChannelModel : public cSimpleModule
      * @param lteInfo pointer to the user control info
      */
     virtual std::vector<double> getSINR(LteAirFrame *frame, UserControlInfo *lteInfo) = 0;
+    /*
+     * Same as above, but the SINR is written into the caller-owned vector snrVector,
+     * whose storage is reused across calls
+     */
+    virtual void getSINR(LteAirFrame *frame, UserControlInfo *lteInfo, std::vector<double>& snrVector) { snrVector = getSINR(frame, lteInfo); }
+    /*
+     * Same as above, used for the computation of the feedback. Channel models may return
+     * the SINR previously computed for the same UE and direction if its inputs did not change
+     */
+    virtual void getFeedbackSINR(LteAirFrame *frame, UserControlInfo *lteInfo, std::vector<double>& snrVector) { getSINR(frame, lteInfo, snrVector); }
+    /*
+     * Compute the wideband SINR, i.e., the SINR averaged over all the bands (used as RSSI for handover)
+     *
+     * @param frame pointer to the packet
+     * @param lteInfo pointer to the user control info
+     */
+    virtual double getWidebandSINR(LteAirFrame *frame, UserControlInfo *lteInfo);
     /*
      * Compute SINR for each band for a background UE according to path loss
      *
@@ -120,6 +196,7 @@ class LteChannelModel : public cSimpleModule
      * @param lteInfo pointer to the user control info
      */
     virtual std::vector<double> getSINR_bgUe(LteAirFrame *frame, UserControlInfo *lteInfo) = 0;
+    virtual void getSINR_bgUe(LteAirFrame *frame, UserControlInfo *lteInfo, std::vector<double>& snrVector) { snrVector = getSINR_bgUe(frame, lteInfo); }
 
     /*
      * Compute received power for a background UE according to path loss
@@ -143,6 +220,18 @@ class LteChannelModel : public cSimpleModule
      * @param lteInfo pointer to the user control info
      */
     virtual std::vector<double> getRSRP(LteAirFrame *frame, UserControlInfo *lteInfo) = 0;
+    virtual void getRSRP(LteAirFrame *frame, UserControlInfo *lteInfo, std::vector<double>& rsrpVector) { rsrpVector = getRSRP(frame, lteInfo); }
+    /*
+     * Compute the received signal of a DL transmission, averaged over all the bands, without
+     * the need of building a frame and its control info (e.g., for cell selection)
+     *
+     * @param txNode MAC node ID of the transmitting eNodeB
+     * @param txPower transmission power (dBm)
+     * @param txCoord position of the transmitting eNodeB
+     * @param rxNode MAC node ID of the receiving UE
+     * @param carrierFrequency carrier frequency of the transmission (the one of this channel model)
+     */
+    virtual double queryRsrp(MacNodeId txNode, double txPower, const inet::Coord& txCoord, MacNodeId rxNode, GHz carrierFrequency);
     /*
      * Compute received useful signal for D2D transmissions
      */
@@ -155,6 +244,11 @@ class LteChannelModel : public cSimpleModule
      */
     virtual std::vector<double> getSINR_D2D(LteAirFrame *frame, UserControlInfo *lteInfo, MacNodeId peerUeId, inet::Coord peerUeCoord, MacNodeId enbId = NODEID_NONE) = 0;
     virtual std::vector<double> getSINR_D2D(LteAirFrame *frame, UserControlInfo *lteInfo_1, MacNodeId destId, inet::Coord destCoord, MacNodeId enbId, const std::vector<double>& rsrpVector) = 0;
+    /*
+     * Same as above, but the SINR is written into the caller-owned vector snrVector
+     */
+    virtual void getSINR_D2D(LteAirFrame *frame, UserControlInfo *lteInfo, MacNodeId peerUeId, inet::Coord peerUeCoord, MacNodeId enbId, std::vector<double>& snrVector) { snrVector = getSINR_D2D(frame, lteInfo, peerUeId, peerUeCoord, enbId); }
+    virtual void getSINR_D2D(LteAirFrame *frame, UserControlInfo *lteInfo_1, MacNodeId destId, inet::Coord destCoord, MacNodeId enbId, const std::vector<double>& rsrpVector, std::vector<double>& snrVector) { snrVector = getSINR_D2D(frame, lteInfo_1, destId, destCoord, enbId, rsrpVector); }
 
     virtual bool isUplinkInterferenceEnabled() { return false; }
     virtual bool isD2DInterferenceEnabled() { return false; }
@@ -27,6 +27,14 @@ class LteDummyChannelModel : public LteChannelModel
     double harqReduction_;
 
   public:
+    // the overloads writing into a caller-owned vector are inherited from LteChannelModel,
+    // which implements them on top of the by-value versions defined here
+    using LteChannelModel::getSIR;
+    using LteChannelModel::getSINR;
+    using LteChannelModel::getRSRP;
+    using LteChannelModel::getSINR_bgUe;
+    using LteChannelModel::getSINR_D2D;
+
     void initialize(int stage) override;
 
     /*
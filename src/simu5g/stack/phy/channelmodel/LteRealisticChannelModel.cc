@@ -91,11 +91,50 @@ void LteRealisticChannelModel::initialize(int stage)
 
         collectSinrStatistics_ = par("collectSinrStatistics");
 
+        enableAttenuationCache_ = par("attenuationCache");
+        enableFeedbackSinrCache_ = par("feedbackSinrCache");
+        feedbackSinrCacheDistance_ = par("feedbackSinrCacheDistance");
+        feedbackSinrCacheMaxAge_ = par("feedbackSinrCacheMaxAge");
+        checkFeedbackSinrCacheHits_ = par("checkFeedbackSinrCacheHits");
+        if (enableFeedbackSinrCache_) {
+            WATCH(numFeedbackSinrCacheHits_[DL]);
+            WATCH(numFeedbackSinrCacheHits_[UL]);
+        }
+        enableJakesFadingCache_ = par("jakesFadingCache");
+        jakesFadingCacheCoherenceFraction_ = par("jakesFadingCacheCoherenceFraction");
+        if (jakesFadingCacheCoherenceFraction_ < 0)
+            throw cRuntimeError("Invalid value of the 'jakesFadingCacheCoherenceFraction' parameter: %f", jakesFadingCacheCoherenceFraction_);
+        enableExtCellInterferenceCache_ = par("extCellInterferenceCache");
+        extCellInterferenceCacheDistance_ = par("extCellInterferenceCacheDistance");
+        enableLinkBudget_ = par("linkBudget");
+        linkBudgetRefreshDistance_ = par("linkBudgetRefreshDistance");
+        fastDbConversion_ = par("fastDbConversion");
+
+        antennaPatternTables_ = par("antennaPatternTables");
+        int antennaPatternTableSize = par("antennaPatternTableSize");
+        if (antennaPatternTables_ && antennaPatternTableSize < 1)
+            throw cRuntimeError("Invalid value of the 'antennaPatternTableSize' parameter: %d", antennaPatternTableSize);
+        antennaPatternTableSize_ = antennaPatternTableSize;
+
         //clear jakes fading map structure
         jakesFadingMap_.clear();
     }
 }
 
+void LteRealisticChannelModel::finish()
+{
+    if (!checkFeedbackSinrCacheHits_)
+        return;
+
+    // with UEs that do not move, a cached feedback sinr can only be invalidated by its maximum age,
+    // hence the feedbacks received in the meantime must have reused it
+    for (Direction dir : { DL, UL }) {
+        if (numFeedbackSinrCacheRefreshes_[dir] > 0 && numFeedbackSinrCacheHits_[dir] == 0)
+            throw cRuntimeError("LteRealisticChannelModel::finish - the feedback sinr cache was refreshed %u times but never reused - DIR=%s",
+                    numFeedbackSinrCacheRefreshes_[dir], dirToA(dir).c_str());
+    }
+}
+
 double LteRealisticChannelModel::getAttenuation(MacNodeId nodeId, Direction dir,
         Coord coord, bool cqiDl)
 {
@@ -118,15 +157,23 @@ double LteRealisticChannelModel::getAttenuation(MacNodeId nodeId, Direction dir,
     // correlation distance the UE could have changed its state and
     // its visibility from eNodeB, hence it is correct to recompute the LOS probability
     if (correlationDist > correlationDistance_
-        || losMap_.find(nodeId) == losMap_.end())
+        || !hasLosState(nodeId))
     {
         computeLosProbability(sqrDistance, nodeId);
     }
 
     //compute attenuation based on selected scenario and based on LOS or NLOS
-    bool los = losMap_[nodeId];
+    bool los = losState(nodeId);
     double dbp = 0;
-    double attenuation = computePathLoss(sqrDistance, dbp, los);
+    double attenuation;
+    double *linkPathLoss = getLinkBudgetPathLoss(nodeId, coord, los);
+    if (linkPathLoss != nullptr && !std::isnan(*linkPathLoss))
+        attenuation = *linkPathLoss;
+    else {
+        attenuation = computePathLoss(sqrDistance, dbp, los);
+        if (linkPathLoss != nullptr)
+            *linkPathLoss = attenuation;
+    }
 
     //    Applying shadowing only if it is enabled by configuration
     //    log-normal shadowing (not available for background UEs)
@@ -152,6 +199,112 @@ double LteRealisticChannelModel::getAttenuation(MacNodeId nodeId, Direction dir,
     return attenuation;
 }
 
+double LteRealisticChannelModel::getCachedAttenuation(MacNodeId nodeId, Direction dir, Coord coord, bool cqiDl)
+{
+    if (!enableAttenuationCache_)
+        return getAttenuation(nodeId, dir, coord, cqiDl);
+
+    // entries are only valid within the TTI they were computed in: drop them all as soon as
+    // the simulation time advances, so that links towards departed nodes do not linger
+    if (attenuationCacheTime_ != NOW) {
+        attenuationCache_.clear();
+        attenuationCacheTime_ = NOW;
+    }
+
+    const Coord& rxCoord = phy_->getCoord();
+    AttenuationCacheKey key(nodeId, dir, cqiDl);
+    auto it = attenuationCache_.find(key);
+    if (it != attenuationCache_.end()) {
+        const AttenuationCacheEntry& entry = it->second;
+        if (entry.txCoord == coord && entry.rxCoord == rxCoord) {
+            EV << "LteRealisticChannelModel::getCachedAttenuation - reusing attenuation " << entry.attenuation << " for node " << nodeId << endl;
+            return entry.attenuation;
+        }
+    }
+
+    // compute attenuation (this must be done before storing the receiver position, which might be updated)
+    double att = getAttenuation(nodeId, dir, coord, cqiDl);
+
+    AttenuationCacheEntry& entry = attenuationCache_[key];
+    entry.txCoord = coord;
+    entry.rxCoord = phy_->getCoord();
+    entry.attenuation = att;
+    return att;
+}
+
+double *LteRealisticChannelModel::getLinkBudgetPathLoss(MacNodeId nodeId, const Coord& coord, bool los)
+{
+    if (!enableLinkBudget_ || num(nodeId) >= BGUE_MIN_ID)
+        return nullptr;
+
+    if (num(nodeId) >= linkBudget_.size())
+        linkBudget_.resize(num(nodeId) + 1);
+
+    LinkBudgetEntry& entry = linkBudget_[num(nodeId)];
+    const Coord& rxCoord = phy_->getCoord();
+    if (!entry.valid || entry.txCoord.distance(coord) > linkBudgetRefreshDistance_ || entry.rxCoord.distance(rxCoord) > linkBudgetRefreshDistance_) {
+        entry.valid = true;
+        entry.txCoord = coord;
+        entry.rxCoord = rxCoord;
+        entry.pathLoss[0] = entry.pathLoss[1] = NAN;
+    }
+    return &entry.pathLoss[los ? 1 : 0];
+}
+
+const LteRealisticChannelModel::InterfererLinkBudget& LteRealisticChannelModel::getInterfererLinkBudget(EnbInfo *enbInfo, const Coord& coord, GHz carrierFrequency)
+{
+    InterfererLinkBudget *entry = &interfererLinkBudgetScratch_;
+    if (enableLinkBudget_) {
+        unsigned int index = num(enbInfo->id);
+        if (index >= interfererLinkBudget_.size())
+            interfererLinkBudget_.resize(index + 1);
+        entry = &interfererLinkBudget_[index];
+
+        // base stations are assumed not to move, only the receiver position is checked
+        if (entry->valid && entry->rxCoord.distance(coord) <= linkBudgetRefreshDistance_)
+            return *entry;
+    }
+
+    // initialize eNB data structures
+    if (!enbInfo->init) {
+        // obtain a reference to eNB phy and obtain tx power
+        enbInfo->phy = check_and_cast<LtePhyBase *>(binder_->getPhyByNodeId(enbInfo->id));
+
+        enbInfo->txPwr = enbInfo->phy->getTxPwr();//dBm
+
+        // get tx direction
+        enbInfo->txDirection = enbInfo->phy->getTxDirection();
+
+        // get tx angle
+        enbInfo->txAngle = enbInfo->phy->getTxAngle();
+
+        //get reference to mac layer
+        enbInfo->mac = check_and_cast<LteMacEnb *>(binder_->getMacByNodeId(enbInfo->id));
+
+        enbInfo->init = true;
+    }
+
+    entry->valid = true;
+    entry->rxCoord = coord;
+    entry->chanModel = dynamic_cast<LteRealisticChannelModel *>(enbInfo->phy->getChannelModel(carrierFrequency));
+    if (entry->chanModel == nullptr)
+        return *entry;
+
+    //=============== ANGULAR ATTENUATION =================
+    double angularAtt = 0;
+    if (enbInfo->txDirection == ANISOTROPIC) {
+        // compute attenuation due to sectorial tx
+        angularAtt = getAngularAttenuation(entry->chanModel->phy_->getCoord(), coord, enbInfo->txAngle);
+
+        EV << "angular attenuation [" << angularAtt << "]";
+    }
+    // else, antenna is omni-directional
+    //=============== END ANGULAR ATTENUATION =================
+
+    entry->txPwr = enbInfo->txPwr - angularAtt - cableLoss_ + antennaGainEnB_ + antennaGainUe_;
+    return *entry;
+}
+
 double LteRealisticChannelModel::getAttenuation_D2D(MacNodeId nodeId, Direction dir, Coord coord, MacNodeId node2_Id, Coord coord_2, bool cqiDl)
 {
     double speed = .0;
@@ -166,24 +319,24 @@ double LteRealisticChannelModel::getAttenuation_D2D(MacNodeId nodeId, Direction
     // correlation distance the UE could have changed its state and
     // its visibility from eNodeB, hence it is correct to recompute the LOS probability
     if (correlationDist > correlationDistance_
-        || losMap_.find(nodeId) == losMap_.end())
+        || !hasLosState(nodeId))
     {
         computeLosProbability(sqrDistance, nodeId);
     }
 
     //compute attenuation based on selected scenario and based on LOS or NLOS
-    bool los = losMap_[nodeId];
+    bool los = losState(nodeId);
     double dbp = 0;
     double attenuation = computePathLoss(sqrDistance, dbp, los);
 
+    // update current user position (before the shadowing, which may depend on it)
+    updatePositionHistory(nodeId, coord);
+
     //    Applying shadowing only if it is enabled by configuration
     //    log-normal shadowing (not available for background UEs)
     if (num(nodeId) < BGUE_MIN_ID && shadowing_)
         attenuation += computeShadowing(sqrDistance, nodeId, speed, cqiDl);
 
-    // update current user position
-    updatePositionHistory(nodeId, coord);
-
     EV << "LteRealisticChannelModel::getAttenuation - computed attenuation at distance " << sqrDistance << " for UE2 is " << attenuation << endl;
 
     return attenuation;
@@ -191,16 +344,6 @@ double LteRealisticChannelModel::getAttenuation_D2D(MacNodeId nodeId, Direction
 
 double LteRealisticChannelModel::computeShadowing(double sqrDistance, MacNodeId nodeId, double speed, bool cqiDl)
 {
-    ShadowFadingMap *actualShadowingMap;
-
-    if (cqiDl) // if we are computing a DL CQI we need the Shadowing Map stored on the UE side
-        actualShadowingMap = obtainShadowingMap(nodeId);
-    else
-        actualShadowingMap = &lastComputedSF_;
-
-    if (actualShadowingMap == nullptr)
-        throw cRuntimeError("LteRealisticChannelModel::computeShadowing - actualShadowingMap not found (nullptr)");
-
     double mean = 0;
     double dbp = 0.0;
     //Get std deviation according to LOS/NLOS and selected scenario
@@ -210,29 +353,40 @@ double LteRealisticChannelModel::computeShadowing(double sqrDistance, MacNodeId
     double space = 0;
     double att;
 
+    NodeChannelState *actualShadowingState;
+
+    if (cqiDl) // if we are computing a DL CQI we need the shadowing stored on the UE side
+        actualShadowingState = obtainUeNodeState(nodeId);
+    else
+        actualShadowingState = &obtainNodeState(nodeId);
+
+    if (actualShadowingState == nullptr)
+        throw cRuntimeError("LteRealisticChannelModel::computeShadowing - actualShadowingState not found (nullptr)");
+
     // if direction is DOWNLINK it means that this module is located in the UE stack than
     // the Move object associated with the UE is myMove_ variable
     // if direction is UPLINK it means that this module is located in the UE stack than
     // the Move object associated with the UE is move variable
 
     // if shadowing for current user has never been computed
-    if (actualShadowingMap->find(nodeId) == actualShadowingMap->end()) {
+    if (!actualShadowingState->hasShadowing) {
         //Get the log-normal shadowing with std deviation stdDev
         att = normal(mean, stdDev);
 
         //store the shadowing attenuation for this user and the temporal mark
-        std::pair<simtime_t, double> tmp(NOW, att);
-        (*actualShadowingMap)[nodeId] = tmp;
+        actualShadowingState->hasShadowing = true;
+        actualShadowingState->shadowingTime = NOW;
+        actualShadowingState->shadowing = att;
 
         //If the shadowing attenuation has been computed at least one time for this user
         // and the distance traveled by the UE is greater than correlation distance
     }
-    else if ((NOW - actualShadowingMap->at(nodeId).first).dbl() * speed
+    else if ((NOW - actualShadowingState->shadowingTime).dbl() * speed
              > correlationDistance_)
     {
 
         //get the temporal mark of the last computed shadowing attenuation
-        time = (NOW - actualShadowingMap->at(nodeId).first).dbl();
+        time = (NOW - actualShadowingState->shadowingTime).dbl();
 
         //compute the traveled distance
         space = time * speed;
@@ -241,64 +395,76 @@ double LteRealisticChannelModel::computeShadowing(double sqrDistance, MacNodeId
         double a = exp(-0.5 * (space / correlationDistance_));
 
         //Get last shadowing attenuation computed
-        double old = actualShadowingMap->at(nodeId).second;
+        double old = actualShadowingState->shadowing;
 
         //Compute shadowing with an EAW (Exponential Average Window) (step 2)
         att = a * old + sqrt(1 - pow(a, 2)) * normal(mean, stdDev);
 
         // Store the new computed shadowing
-        std::pair<simtime_t, double> tmp(NOW, att);
-        (*actualShadowingMap)[nodeId] = tmp;
+        actualShadowingState->shadowingTime = NOW;
+        actualShadowingState->shadowing = att;
 
         // if the distance traveled by the UE is smaller than correlation distance shadowing attenuation remains the same
     }
     else {
-        att = actualShadowingMap->at(nodeId).second;
+        att = actualShadowingState->shadowing;
     }
 
     return att;
 }
 
+LteRealisticChannelModel::NodeChannelState& LteRealisticChannelModel::obtainNodeState(const MacNodeId nodeId)
+{
+    unsigned short id = num(nodeId);
+    if (nodeStateIndex_.size() <= id)
+        nodeStateIndex_.resize(id + 1, 0);
+    if (nodeStateIndex_[id] == 0) {
+        nodeStates_.emplace_back();
+        nodeStateIndex_[id] = nodeStates_.size();
+    }
+    return nodeStates_[nodeStateIndex_[id] - 1];
+}
+
 void LteRealisticChannelModel::updatePositionHistory(const MacNodeId nodeId,
         const Coord coord)
 {
-    if (positionHistory_.find(nodeId) != positionHistory_.end()) {
-        // position already updated for this TTI.
-        if (positionHistory_[nodeId].back().first == NOW)
-            return;
-    }
+    PositionHistory& positionHistory = obtainNodeState(nodeId).positionHistory;
 
-    // FIXME: possible memory leak
-    positionHistory_[nodeId].push(Position(NOW, coord));
+    // position already updated for this TTI.
+    if (positionHistory.size > 0 && positionHistory.back().first == NOW)
+        return;
 
-    if (positionHistory_[nodeId].size() > 2) // if we have more than a past and a current element
-        // drop the oldest one
-        positionHistory_[nodeId].pop();
+    // if we have more than a past and a current element, the oldest one is dropped
+    positionHistory.push(Position(NOW, coord));
 }
 
 void LteRealisticChannelModel::updateCorrelationDistance(const MacNodeId nodeId, const inet::Coord coord) {
 
-    if (lastCorrelationPoint_.find(nodeId) == lastCorrelationPoint_.end()) {
+    NodeChannelState& state = obtainNodeState(nodeId);
+    if (!state.hasCorrelationPoint) {
         // no lastCorrelationPoint set current point.
-        lastCorrelationPoint_[nodeId] = Position(NOW, coord);
+        state.hasCorrelationPoint = true;
+        state.lastCorrelationPoint = Position(NOW, coord);
     }
-    else if ((lastCorrelationPoint_[nodeId].first != NOW) &&
-             lastCorrelationPoint_[nodeId].second.distance(coord) > correlationDistance_)
+    else if ((state.lastCorrelationPoint.first != NOW) &&
+             state.lastCorrelationPoint.second.distance(coord) > correlationDistance_)
     {
         // check simtime_t first
-        lastCorrelationPoint_[nodeId] = Position(NOW, coord);
+        state.lastCorrelationPoint = Position(NOW, coord);
     }
 }
 
 double LteRealisticChannelModel::computeCorrelationDistance(const MacNodeId nodeId, const inet::Coord coord) {
     double dist = 0.0;
 
-    if (lastCorrelationPoint_.find(nodeId) == lastCorrelationPoint_.end()) {
+    NodeChannelState& state = obtainNodeState(nodeId);
+    if (!state.hasCorrelationPoint) {
         // no lastCorrelationPoint found. Add current position and return dist = 0.0
-        lastCorrelationPoint_[nodeId] = Position(NOW, coord);
+        state.hasCorrelationPoint = true;
+        state.lastCorrelationPoint = Position(NOW, coord);
     }
     else {
-        dist = lastCorrelationPoint_[nodeId].second.distance(coord);
+        dist = state.lastCorrelationPoint.second.distance(coord);
     }
     return dist;
 }
@@ -308,24 +474,26 @@ double LteRealisticChannelModel::computeSpeed(const MacNodeId nodeId,
 {
     double speed = 0.0;
 
-    if (positionHistory_.find(nodeId) == positionHistory_.end()) {
+    NodeChannelState *state = findNodeState(nodeId);
+    if (state == nullptr || state->positionHistory.size == 0) {
         // no entries
         return speed;
     }
     else {
         //compute distance traveled from last update by UE (eNodeB position is fixed)
+        const PositionHistory& positionHistory = state->positionHistory;
 
-        if (positionHistory_[nodeId].size() == 1) {
+        if (positionHistory.size == 1) {
             //  the only element refers to the present, return 0
             return speed;
         }
 
-        double movement = positionHistory_[nodeId].front().second.distance(coord);
+        double movement = positionHistory.front().second.distance(coord);
 
         if (movement <= 0.0)
             return speed;
         else {
-            double time = (NOW.dbl()) - (positionHistory_[nodeId].front().first.dbl());
+            double time = (NOW.dbl()) - (positionHistory.front().first.dbl());
             if (time <= 0.0) // time not updated since last speed call
                 throw cRuntimeError("Multiple entries detected in position history referring to the same time");
             // compute speed
@@ -392,7 +560,80 @@ double LteRealisticChannelModel::computeAngularAttenuation(double hAngle, double
     return angularAtt;
 }
 
+void LteRealisticChannelModel::initAntennaPatternTables()
+{
+    // the attenuation is the sum of a horizontal and a vertical component, limited to a maximum value
+    // (TR 36.814, TR 38.901), hence the two components can be tabulated separately. The tables are indexed
+    // by the cosine of the angles, so that looking them up does not need any trigonometric function
+    unsigned int n = antennaPatternTableSize_;
+    hPatternTable_.resize(n + 1);
+    vPatternTable_.resize(n + 1);
+    for (unsigned int k = 0; k <= n; k++) {
+        double hAngle = acos(-1.0 + 2.0 * k / n) * 180.0 / M_PI;
+        hPatternTable_[k] = computeAngularAttenuation(hAngle, 90);
+
+        double vAngle = 90 + acos((double)k / n) * 180.0 / M_PI;
+        vPatternTable_[k] = computeAngularAttenuation(0, vAngle);
+    }
+    maxAngularAtt_ = computeAngularAttenuation(180, 180);
+}
+
+double LteRealisticChannelModel::getAngularAttenuation(const Coord& txCoord, const Coord& rxCoord, double txAngle)
+{
+    double dx = rxCoord.x - txCoord.x;
+    double dy = rxCoord.y - txCoord.y;
+    double dz = rxCoord.z - txCoord.z;
+    double threeDimDistance = sqrt(dx * dx + dy * dy + dz * dz);
+
+    if (!antennaPatternTables_ || threeDimDistance == 0) {
+        // compute the angle between rx position and reference axis, considering the transmitter as center
+        double rxAngle = computeAngle(txCoord, rxCoord);
+
+        // compute the reception angle between receiver and transmitter
+        double recvAngle = fabs(txAngle - rxAngle);
+
+        if (recvAngle > 180)
+            recvAngle = 360 - recvAngle;
+
+        double verticalAngle = computeVerticalAngle(txCoord, rxCoord);
+
+        return computeAngularAttenuation(recvAngle, verticalAngle);
+    }
+
+    if (hPatternTable_.empty())
+        initAntennaPatternTables();
+
+    auto it = boresightDirections_.find(txAngle);
+    if (it == boresightDirections_.end())
+        it = boresightDirections_.emplace(txAngle, std::make_pair(cos(txAngle * M_PI / 180.0), sin(txAngle * M_PI / 180.0))).first;
+
+    // as computeAngle() does, measure the horizontal angle on the plane containing the y axis and the receiver
+    double hx = sqrt(dx * dx + dz * dz);
+    if (dx < 0)
+        hx = -hx;
+    double cosH = (hx * it->second.first + dy * it->second.second) / threeDimDistance;
+    double cosV = sqrt(dx * dx + dy * dy) / threeDimDistance;
+
+    // linear interpolation between the closest entries of the tables
+    double n = antennaPatternTableSize_;
+    double hPos = std::min(std::max((cosH + 1) / 2, 0.0), 1.0) * n;
+    double vPos = std::min(cosV, 1.0) * n;
+    unsigned int h = std::min((unsigned int)hPos, antennaPatternTableSize_ - 1);
+    unsigned int v = std::min((unsigned int)vPos, antennaPatternTableSize_ - 1);
+    double angularAtt = hPatternTable_[h] + (hPos - h) * (hPatternTable_[h + 1] - hPatternTable_[h])
+        + vPatternTable_[v] + (vPos - v) * (vPatternTable_[v + 1] - vPatternTable_[v]);
+
+    return std::min(angularAtt, maxAngularAtt_);
+}
+
 std::vector<double> LteRealisticChannelModel::getSINR(LteAirFrame *frame, UserControlInfo *lteInfo)
+{
+    std::vector<double> snrVector;
+    getSINR(frame, lteInfo, snrVector);
+    return snrVector;
+}
+
+void LteRealisticChannelModel::getSINR(LteAirFrame *frame, UserControlInfo *lteInfo, std::vector<double>& snrVector)
 {
     // get tx power
     double recvPower = lteInfo->getTxPower(); // dBm
@@ -532,19 +773,8 @@ std::vector<double> LteRealisticChannelModel::getSINR(LteAirFrame *frame, UserCo
             // get tx angle
             double txAngle = ltePhy->getTxAngle();
 
-            // compute the angle between uePosition and reference axis, considering the eNb as center
-            double ueAngle = computeAngle(enbCoord, ueCoord);
-
-            // compute the reception angle between ue and eNb
-            double recvAngle = fabs(txAngle - ueAngle);
-
-            if (recvAngle > 180)
-                recvAngle = 360 - recvAngle;
-
-            double verticalAngle = computeVerticalAngle(enbCoord, ueCoord);
-
             // compute attenuation due to sectorial tx
-            double angularAtt = computeAngularAttenuation(recvAngle, verticalAngle);
+            double angularAtt = getAngularAttenuation(enbCoord, ueCoord, txAngle);
 
             recvPower -= angularAtt;
         }
@@ -552,14 +782,17 @@ std::vector<double> LteRealisticChannelModel::getSINR(LteAirFrame *frame, UserCo
     }
     //=============== END ANGULAR ATTENUATION =================
 
-    std::vector<double> snrVector;
-    snrVector.resize(numBands_, 0.0);
+    snrVector.assign(numBands_, 0.0);
 
     // compute and add interference due to fading
     // Apply fading for each band
     // if the phy layer is localized we can assume that for each logical band we have different fading attenuation
     // if the phy layer is distributed the number of logical bands should be set to 1
     double fadingAttenuation = 0;
+    // compute Jakes fading for all the bands in one pass
+    std::vector<double>& jakesFadingVector = jakesFadingBuffer_;
+    if (fading_ && fadingType_ == JAKES)
+        computeJakesFading(ueId, speed, cqiDl, false, jakesFadingVector);
 
     // for each logical band
     // FIXME compute fading only for used RBs
@@ -572,7 +805,7 @@ std::vector<double> LteRealisticChannelModel::getSINR(LteAirFrame *frame, UserCo
                 fadingAttenuation = rayleighFading(ueId, i);
 
             else if (fadingType_ == JAKES)
-                fadingAttenuation = jakesFading(ueId, speed, i, cqiDl);
+                fadingAttenuation = jakesFadingVector[i];
         }
         // add fading contribution to the received power
         double finalRecvPower = recvPower + fadingAttenuation; // (dBm+dB)=dBm
@@ -606,9 +839,9 @@ std::vector<double> LteRealisticChannelModel::getSINR(LteAirFrame *frame, UserCo
 
     //============ MULTI CELL INTERFERENCE COMPUTATION =================
     // vector containing the sum of multi-cell interference for each band
-    std::vector<double> multiCellInterference; // Linear value (mW)
+    std::vector<double>& multiCellInterference = multiCellInterferenceBuffer_; // Linear value (mW)
     // prepare data structure
-    multiCellInterference.resize(numBands_, 0);
+    multiCellInterference.assign(numBands_, 0);
     if (enableDownlinkInterference_ && dir == DL && lteInfo->getFrameType() != HANDOVERPKT) {
         computeDownlinkInterference(eNbId, ueId, ueCoord, (lteInfo->getFrameType() == FEEDBACKPKT), lteInfo->getCarrierFrequency(), rbmap, &multiCellInterference);
     }
@@ -618,9 +851,9 @@ std::vector<double> LteRealisticChannelModel::getSINR(LteAirFrame *frame, UserCo
 
     //============ BACKGROUND CELLS INTERFERENCE COMPUTATION =================
     // vector containing the sum of background cell interference for each band
-    std::vector<double> bgCellInterference; // Linear value (mW)
+    std::vector<double>& bgCellInterference = bgCellInterferenceBuffer_; // Linear value (mW)
     // prepare data structure
-    bgCellInterference.resize(numBands_, 0);
+    bgCellInterference.assign(numBands_, 0);
     if (enableBackgroundCellInterference_) {
         computeBackgroundCellInterference(ueId, enbCoord, ueCoord, (lteInfo->getFrameType() == FEEDBACKPKT), lteInfo->getCarrierFrequency(), rbmap, dir, &bgCellInterference); // dBm
     }
@@ -628,9 +861,9 @@ std::vector<double> LteRealisticChannelModel::getSINR(LteAirFrame *frame, UserCo
     //============ EXTCELL INTERFERENCE COMPUTATION =================
     // TODO this might be obsolete as it is replaced by background cell interference
     // vector containing the sum of external cell interference for each band
-    std::vector<double> extCellInterference; // Linear value (mW)
+    std::vector<double>& extCellInterference = extCellInterferenceBuffer_; // Linear value (mW)
     // prepare data structure
-    extCellInterference.resize(numBands_, 0);
+    extCellInterference.assign(numBands_, 0);
     if (enableExtCellInterference_ && dir == DL) {
         computeExtCellInterference(eNbId, ueId, ueCoord, (lteInfo->getFrameType() == FEEDBACKPKT), lteInfo->getCarrierFrequency(), &extCellInterference); // dBm
     }
@@ -639,8 +872,13 @@ std::vector<double> LteRealisticChannelModel::getSINR(LteAirFrame *frame, UserCo
     // compute and linearize total noise
     double totN = dBmToLinear(thermalNoise_ + noiseFigure);
 
-    // denominator expressed in dBm as (N+extCell+bgCell+multiCell)
-    double den;
+    // denominator expressed in dBm as (N+extCell+bgCell+multiCell), converted for all the bands at once
+    std::vector<double>& den = denominatorBuffer_;
+    den.resize(numBands_);
+    for (unsigned int i = 0; i < numBands_; i++)
+        //       (      mW              +          mW            +  mW  +        mW            )
+        den[i] = bgCellInterference[i] + extCellInterference[i] + totN + multiCellInterference[i];
+    linearToDBm(den.data(), den.data(), numBands_, fastDbConversion_);
     EV << "LteRealisticChannelModel::getSINR - distance from my eNb=" << enbCoord.distance(ueCoord) << " - DIR=" << ((dir == DL) ? "DL" : "UL") << endl;
 
     double sumSnr = 0.0;
@@ -652,30 +890,19 @@ std::vector<double> LteRealisticChannelModel::getSINR(LteAirFrame *frame, UserCo
         if (lteInfo->getFrameType() == DATAPKT && rbmap[MACRO][i] == 0)
             continue;
 
-        //               (      mW              +          mW            +  mW  +        mW            )
-        den = linearToDBm(bgCellInterference[i] + extCellInterference[i] + totN + multiCellInterference[i]);
-
         EV << "\t bgCell[" << bgCellInterference[i] << "] - ext[" << extCellInterference[i] << "] - multi[" << multiCellInterference[i] << "] - recvPwr["
-           << dBmToLinear(snrVector[i]) << "] - sinr[" << snrVector[i] - den << "]\n";
+           << dBmToLinear(snrVector[i]) << "] - sinr[" << snrVector[i] - den[i] << "]\n";
 
         // compute final SINR
-        snrVector[i] -= den;
+        snrVector[i] -= den[i];
 
         sumSnr += snrVector[i];
         ++usedRBs;
     }
 
     // emit SINR statistic
-    if (collectSinrStatistics_ && (lteInfo->getFrameType() == FEEDBACKPKT) && usedRBs > 0) {
-        // we are on the BS, so we need to retrieve the channel model of the sender
-        // XXX I know, there might be a faster way...
-        LteChannelModel *ueChannelModel = check_and_cast<LtePhyUe *>(binder_->getPhyByNodeId(ueId))->getChannelModel(lteInfo->getCarrierFrequency());
-
-        if (dir == DL) // we are on the UE
-            ueChannelModel->emit(measuredSinrDlSignal_, sumSnr / usedRBs);
-        else
-            ueChannelModel->emit(measuredSinrUlSignal_, sumSnr / usedRBs);
-    }
+    if (collectSinrStatistics_ && (lteInfo->getFrameType() == FEEDBACKPKT) && usedRBs > 0)
+        emitMeasuredSinr(ueId, dir, lteInfo->getCarrierFrequency(), sumSnr / usedRBs);
 
     // if sender is an eNodeB
     if (dir == DL)
@@ -684,20 +911,184 @@ std::vector<double> LteRealisticChannelModel::getSINR(LteAirFrame *frame, UserCo
     // sender is a UE
     else
         updatePositionHistory(ueId, coord);
-    return snrVector;
+}
+
+void LteRealisticChannelModel::emitMeasuredSinr(MacNodeId ueId, Direction dir, GHz carrierFrequency, double sinr)
+{
+    // we are on the BS, so we need to retrieve the channel model of the sender
+    // XXX I know, there might be a faster way...
+    LteChannelModel *ueChannelModel = check_and_cast<LtePhyUe *>(binder_->getPhyByNodeId(ueId))->getChannelModel(carrierFrequency);
+
+    if (dir == DL) // we are on the UE
+        ueChannelModel->emit(measuredSinrDlSignal_, sinr);
+    else
+        ueChannelModel->emit(measuredSinrUlSignal_, sinr);
+}
+
+void LteRealisticChannelModel::getFeedbackSINR(LteAirFrame *frame, UserControlInfo *lteInfo, std::vector<double>& snrVector)
+{
+    // the interference from background cells also depends on the position of background UEs, which is not tracked
+    if (!enableFeedbackSinrCache_ || enableBackgroundCellInterference_) {
+        getSINR(frame, lteInfo, snrVector);
+        return;
+    }
+
+    MacNodeId ueId = lteInfo->getSourceId();
+    MacNodeId eNbId = lteInfo->getDestId();
+    Direction dir = (Direction)lteInfo->getDirection();
+    Coord ueCoord = lteInfo->getCoord();
+    Coord enbCoord = phy_->getCoord();
+    uint64_t signature = computeInterferenceSignature(eNbId, dir, lteInfo->getCarrierFrequency());
+
+    auto it = feedbackSinrCache_.find(std::make_pair(ueId, dir));
+    if (it != feedbackSinrCache_.end()) {
+        const FeedbackSinrCacheEntry& entry = it->second;
+        if (NOW < entry.expiration && entry.txPower == lteInfo->getTxPower() && entry.interferenceSignature == signature
+            && entry.ueCoord.distance(ueCoord) <= feedbackSinrCacheDistance_ && entry.enbCoord.distance(enbCoord) <= feedbackSinrCacheDistance_)
+        {
+            EV << "LteRealisticChannelModel::getFeedbackSINR - reusing the sinr computed at " << entry.expiration << " for node " << ueId << " - DIR=" << dirToA(dir) << endl;
+            snrVector = entry.sinr;
+            numFeedbackSinrCacheHits_[dir]++;
+
+            if (collectSinrStatistics_ && !snrVector.empty()) {
+                double sumSnr = 0.0;
+                for (double snr : snrVector)
+                    sumSnr += snr;
+                emitMeasuredSinr(ueId, dir, lteInfo->getCarrierFrequency(), sumSnr / snrVector.size());
+            }
+            return;
+        }
+        numFeedbackSinrCacheRefreshes_[dir]++;
+    }
+
+    // the coherence time of the channel bounds the lifetime of the entry: compute the speed
+    // before getSINR() updates the position history. For feedback frames, getSINR() tracks the
+    // position of the UE in both directions
+    simtime_t lifetime = feedbackSinrCacheMaxAge_;
+    if (fading_) {
+        double speed = computeSpeed(ueId, ueCoord);
+        double dopplerShift = speed * carrierFrequencyHz_ / SPEED_OF_LIGHT;
+        if (dopplerShift > 0)
+            lifetime = std::min(lifetime, simtime_t(0.423 / dopplerShift));
+    }
+
+    getSINR(frame, lteInfo, snrVector);
+
+    FeedbackSinrCacheEntry& entry = feedbackSinrCache_[std::make_pair(ueId, dir)];
+    entry.expiration = NOW + lifetime;
+    entry.ueCoord = ueCoord;
+    entry.enbCoord = enbCoord;
+    entry.txPower = lteInfo->getTxPower();
+    // the interfering eNBs might have been initialized by getSINR()
+    entry.interferenceSignature = computeInterferenceSignature(eNbId, dir, lteInfo->getCarrierFrequency());
+    entry.sinr = snrVector;
+}
+
+uint64_t LteRealisticChannelModel::computeInterferenceSignature(MacNodeId eNbId, Direction dir, GHz carrierFrequency)
+{
+    // FNV-1a hash
+    uint64_t hash = 14695981039346656037ULL;
+    auto mix = [&hash](uint64_t value) {
+        hash = (hash ^ value) * 1099511628211ULL;
+    };
+
+    if (dir == DL && enableDownlinkInterference_) {
+        for (auto& enbInfo : binder_->getEnbList()) {
+            if (enbInfo->id == eNbId)
+                continue;
+
+            mix(num(enbInfo->id));
+            if (!enbInfo->init)
+                continue;
+
+            LteChannelModel *interfChanModel = enbInfo->phy->getChannelModel(carrierFrequency);
+            if (interfChanModel == nullptr)
+                continue;
+
+            unsigned int numBands = std::min(numBands_, interfChanModel->getNumBands());
+            for (unsigned int i = 0; i < numBands; i++)
+                mix(enbInfo->mac->getDlBandStatus(i));
+        }
+    }
+
+    if (dir == UL && enableUplinkInterference_) {
+        const UlTransmissionMap *ulTransmissionMap = binder_->getUlTransmissionMap(carrierFrequency, CURR_TTI);
+        if (ulTransmissionMap != nullptr) {
+            for (unsigned int i = ulTransmissionMap->nextOccupiedBand(0); i < numBands_; i = ulTransmissionMap->nextOccupiedBand(i + 1)) {
+                mix(i);
+                for (const auto& ueInfo : ulTransmissionMap->at(i)) {
+                    mix(num(ueInfo.nodeId));
+                    Coord ueCoord = (ueInfo.phy != nullptr) ? ueInfo.phy->getCoord() : ueInfo.trafficGen->getCoord();
+                    mix((int64_t)floor(ueCoord.x / feedbackSinrCacheDistance_));
+                    mix((int64_t)floor(ueCoord.y / feedbackSinrCacheDistance_));
+                    mix((int64_t)floor(ueCoord.z / feedbackSinrCacheDistance_));
+                }
+            }
+        }
+    }
+
+    if (enableExtCellInterference_) {
+        for (auto& extCell : binder_->getExtCellList(carrierFrequency)) {
+            unsigned int numBands = std::min(numBands_, extCell->getNumBands());
+            for (unsigned int i = 0; i < numBands; i++)
+                mix(extCell->getBandStatus(i));
+        }
+    }
+
+    return hash;
+}
+
+double LteRealisticChannelModel::getWidebandSINR(LteAirFrame *frame, UserControlInfo *lteInfo)
+{
+    // go through the virtual getSINR(), so that the wideband value follows the same pipeline as
+    // the per-band one (including the overrides of subclasses)
+    std::vector<double>& snrVector = widebandSinrBuffer_;
+    getSINR(frame, lteInfo, snrVector);
+
+    double sumSnr = 0.0;
+    for (double snr : snrVector)
+        sumSnr += snr;
+    return sumSnr / snrVector.size();
 }
 
 std::vector<double> LteRealisticChannelModel::getRSRP(LteAirFrame *frame, UserControlInfo *lteInfo)
 {
-    // get tx power
-    double recvPower = lteInfo->getTxPower(); // dBm
+    std::vector<double> rsrpVector;
+    getRSRP(frame, lteInfo, rsrpVector);
+    return rsrpVector;
+}
 
-    // Get the Resource Blocks used to transmit this packet
-    RbMap rbmap = lteInfo->getGrantedBlocks();
+void LteRealisticChannelModel::getRSRP(LteAirFrame *frame, UserControlInfo *lteInfo, std::vector<double>& rsrpVector)
+{
+    Direction dir = (Direction)lteInfo->getDirection();
+    bool feedback = (lteInfo->getFrameType() == FEEDBACKPKT);
 
-    // get move object associated with the packet
-    // this object is referred to eNodeB if the direction is DL or UE if the direction is UL
-    Coord coord = lteInfo->getCoord();
+    // the sender is the eNB for the DL error computation, the UE otherwise
+    if (dir == DL && !feedback)
+        computeRSRP(lteInfo->getDestId(), lteInfo->getSourceId(), dir, feedback, lteInfo->getTxPower(), lteInfo->getCoord(), rsrpVector);
+    else
+        computeRSRP(lteInfo->getSourceId(), lteInfo->getDestId(), dir, feedback, lteInfo->getTxPower(), lteInfo->getCoord(), rsrpVector);
+}
+
+double LteRealisticChannelModel::queryRsrp(MacNodeId txNode, double txPower, const Coord& txCoord, MacNodeId rxNode, GHz carrierFrequency)
+{
+    if (carrierFrequency != carrierFrequency_)
+        throw cRuntimeError("LteRealisticChannelModel::queryRsrp - carrier frequency %f GHz is not handled by this channel model", carrierFrequency.get());
+
+    std::vector<double>& rsrpVector = rsrpQueryBuffer_;
+    computeRSRP(rxNode, txNode, DL, false, txPower, txCoord, rsrpVector);
+
+    // compute the mean over all RBs
+    double rsrp = 0;
+    for (auto value : rsrpVector)
+        rsrp += value;
+    return rsrp / rsrpVector.size();
+}
+
+void LteRealisticChannelModel::computeRSRP(MacNodeId ueId, MacNodeId eNbId, Direction dir, bool feedback, double txPower, const Coord& coord, std::vector<double>& rsrpVector)
+{
+    // get tx power
+    double recvPower = txPower; // dBm
 
     // position of eNb and UE
     Coord ueCoord;
@@ -711,11 +1102,6 @@ std::vector<double> LteRealisticChannelModel::getRSRP(LteAirFrame *frame, UserCo
     // true if we are computing a CQI for the DL direction
     bool cqiDl = false;
 
-    MacNodeId ueId = NODEID_NONE;
-    MacNodeId eNbId = NODEID_NONE;
-
-    Direction dir = (Direction)lteInfo->getDirection();
-
     EV << "------------ GET SINR ----------------" << endl;
     // ===================== PARAMETERS SETUP ============================
     /*
@@ -724,20 +1110,16 @@ std::vector<double> LteRealisticChannelModel::getRSRP(LteAirFrame *frame, UserCo
      *
      *         Downlink error computation
      */
-    if (dir == DL && (lteInfo->getFrameType() != FEEDBACKPKT)) {
+    if (dir == DL && !feedback) {
         // set noise Figure
         noiseFigure = ueNoiseFigure_; // dB
         // set antenna gain Figure
         antennaGainTx = antennaGainEnB_; // dB
         antennaGainRx = antennaGainUe_;  // dB
 
-        // get MacId for UE and eNB
-        ueId = lteInfo->getDestId();
-        eNbId = lteInfo->getSourceId();
-
         // get position of UE and eNB
         ueCoord = phy_->getCoord();
-        enbCoord = lteInfo->getCoord();
+        enbCoord = coord;
 
         speed = computeSpeed(ueId, phy_->getCoord());
     }
@@ -747,14 +1129,9 @@ std::vector<double> LteRealisticChannelModel::getRSRP(LteAirFrame *frame, UserCo
      * it means that this function is called by the feedback computation module
      *
      * located in the eNodeB that computes the feedback received by the UE
-     * Hence the UE macNodeId can be taken from the sourceId of the lteInfo
-     * and the speed of the UE is contained in the Move object associated with the lteInfo
+     * Hence the UE is the sender and coord is its position
      */
     else { // UL/DL CQI & UL error computation
-        // get MacId for UE and eNB
-        ueId = lteInfo->getSourceId();
-        eNbId = lteInfo->getDestId();
-
         if (dir == DL) {
             // set noise Figure
             noiseFigure = ueNoiseFigure_; // dB
@@ -784,23 +1161,21 @@ std::vector<double> LteRealisticChannelModel::getRSRP(LteAirFrame *frame, UserCo
     CellInfo *eNbCell = binder_->getCellInfoByNodeId(eNbId);
     const char *eNbTypeString = eNbCell ? (eNbCell->getEnbType() == MACRO_ENB ? "MACRO" : "MICRO") : "NULL";
 
-    EV << "LteRealisticChannelModel::getRSRP - srcId=" << lteInfo->getSourceId()
-       << " - destId=" << lteInfo->getDestId()
-       << " - DIR=" << ((dir == DL) ? "DL" : "UL")
-       << " - frameType=" << ((lteInfo->getFrameType() == FEEDBACKPKT) ? "feedback" : "other")
+    EV << "LteRealisticChannelModel::getRSRP - DIR=" << ((dir == DL) ? "DL" : "UL")
+       << " - frameType=" << (feedback ? "feedback" : "other")
        << endl
-       << eNbTypeString << " - txPwr " << lteInfo->getTxPower()
+       << eNbTypeString << " - txPwr " << txPower
        << " - ueCoord[" << ueCoord << "] - enbCoord[" << enbCoord << "] - ueId[" << ueId << "] - enbId[" << eNbId << "]" <<
         endl;
     // =================== END PARAMETERS SETUP =======================
 
     // =============== PATH LOSS + SHADOWING + FADING =================
     EV << "\t using parameters - noiseFigure=" << noiseFigure << " - antennaGainTx=" << antennaGainTx << " - antennaGainRx=" << antennaGainRx <<
-        " - txPwr=" << lteInfo->getTxPower() << " - for ueId=" << ueId << endl;
+        " - txPwr=" << txPower << " - for ueId=" << ueId << endl;
 
     // attenuation for the desired signal
     double attenuation;
-    if ((lteInfo->getFrameType() == FEEDBACKPKT))
+    if (feedback)
         attenuation = getAttenuation(ueId, UL, coord, cqiDl); // dB
     else
         attenuation = getAttenuation(ueId, dir, coord, cqiDl); // dB
@@ -827,19 +1202,8 @@ std::vector<double> LteRealisticChannelModel::getRSRP(LteAirFrame *frame, UserCo
             // get tx angle
             double txAngle = ltePhy->getTxAngle();
 
-            // compute the angle between uePosition and reference axis, considering the eNB as center
-            double ueAngle = computeAngle(enbCoord, ueCoord);
-
-            // compute the reception angle between ue and eNB
-            double recvAngle = fabs(txAngle - ueAngle);
-
-            if (recvAngle > 180)
-                recvAngle = 360 - recvAngle;
-
-            double verticalAngle = computeVerticalAngle(enbCoord, ueCoord);
-
             // compute attenuation due to sectorial tx
-            double angularAtt = computeAngularAttenuation(recvAngle, verticalAngle);
+            double angularAtt = getAngularAttenuation(enbCoord, ueCoord, txAngle);
 
             recvPower -= angularAtt;
         }
@@ -847,14 +1211,17 @@ std::vector<double> LteRealisticChannelModel::getRSRP(LteAirFrame *frame, UserCo
     }
     // =============== END ANGULAR ATTENUATION =================
 
-    std::vector<double> rsrpVector;
-    rsrpVector.resize(numBands_, 0.0);
+    rsrpVector.assign(numBands_, 0.0);
 
     // compute and add interference due to fading
     // Apply fading for each band
     // if the phy layer is localized we can assume that for each logical band we have different fading attenuation
     // if the phy layer is distributed the number of logical bands should be set to 1
     double fadingAttenuation = 0;
+    // compute Jakes fading for all the bands in one pass
+    std::vector<double>& jakesFadingVector = jakesFadingBuffer_;
+    if (fading_ && fadingType_ == JAKES)
+        computeJakesFading(ueId, speed, cqiDl, false, jakesFadingVector);
 
     // for each logical band
     // FIXME compute fading only for used RBs
@@ -867,14 +1234,13 @@ std::vector<double> LteRealisticChannelModel::getRSRP(LteAirFrame *frame, UserCo
                 fadingAttenuation = rayleighFading(ueId, i);
 
             else if (fadingType_ == JAKES)
-                fadingAttenuation = jakesFading(ueId, speed, i, cqiDl);
+                fadingAttenuation = jakesFadingVector[i];
         }
         // add fading contribution to the received power
         double finalRecvPower = recvPower + fadingAttenuation; // (dBm+dB)=dBm
 
         EV << " LteRealisticChannelModel::getRSRP node " << ueId
-           << ((lteInfo->getFrameType() == FEEDBACKPKT) ?
-            " FEEDBACK PACKET " : " NORMAL PACKET ")
+           << (feedback ? " FEEDBACK PACKET " : " NORMAL PACKET ")
            << " band " << i << " recvPower " << recvPower
            << " direction " << dirToA(dir) << " antenna gain tx "
            << antennaGainTx << " antenna gain rx " << antennaGainRx
@@ -887,11 +1253,16 @@ std::vector<double> LteRealisticChannelModel::getRSRP(LteAirFrame *frame, UserCo
         rsrpVector[i] = finalRecvPower;
     }
     // ============ END PATH LOSS + SHADOWING + FADING ===============
-
-    return rsrpVector;
 }
 
 std::vector<double> LteRealisticChannelModel::getSINR_bgUe(LteAirFrame *frame, UserControlInfo *lteInfo)
+{
+    std::vector<double> snrVector;
+    getSINR_bgUe(frame, lteInfo, snrVector);
+    return snrVector;
+}
+
+void LteRealisticChannelModel::getSINR_bgUe(LteAirFrame *frame, UserControlInfo *lteInfo, std::vector<double>& snrVector)
 {
     //get tx power
     double recvPower = lteInfo->getTxPower(); // dBm
@@ -975,30 +1346,22 @@ std::vector<double> LteRealisticChannelModel::getSINR_bgUe(LteAirFrame *frame, U
             // get tx angle
             double txAngle = ltePhy->getTxAngle();
 
-            // compute the angle between uePosition and reference axis, considering the eNb as center
-            double ueAngle = computeAngle(enbCoord, ueCoord);
-
-            // compute the reception angle between ue and eNb
-            double recvAngle = fabs(txAngle - ueAngle);
-
-            if (recvAngle > 180)
-                recvAngle = 360 - recvAngle;
-
-            double verticalAngle = computeVerticalAngle(enbCoord, ueCoord);
-
             // compute attenuation due to sectorial tx
-            double angularAtt = computeAngularAttenuation(recvAngle, verticalAngle);
+            double angularAtt = getAngularAttenuation(enbCoord, ueCoord, txAngle);
 
             recvPower -= angularAtt;
         }
         // else, antenna is omni-directional
     }
 
-    std::vector<double> snrVector;
-    snrVector.resize(numBands_, recvPower);
+    snrVector.assign(numBands_, recvPower);
 
     // for each logical band
     double fadingAttenuation = 0;
+    // compute Jakes fading for all the bands in one pass
+    std::vector<double>& jakesFadingVector = jakesFadingBuffer_;
+    if (fading_ && fadingType_ == JAKES)
+        computeJakesFading(bgUeId, speed, cqiDl, true, jakesFadingVector);
     for (unsigned int i = 0; i < numBands_; i++) {
         //if fading is enabled
         if (fading_) {
@@ -1007,7 +1370,7 @@ std::vector<double> LteRealisticChannelModel::getSINR_bgUe(LteAirFrame *frame, U
                 fadingAttenuation = rayleighFading(bgUeId, i);
 
             else if (fadingType_ == JAKES)
-                fadingAttenuation = jakesFading(bgUeId, speed, i, cqiDl, true);
+                fadingAttenuation = jakesFadingVector[i];
         }
         // add fading contribution to the received power
         double finalRecvPower = recvPower + fadingAttenuation; // (dBm+dB)=dBm
@@ -1035,9 +1398,9 @@ std::vector<double> LteRealisticChannelModel::getSINR_bgUe(LteAirFrame *frame, U
     bool isCqi = true;
     RbMap rbmap;
     //vector containing the sum of multicell interference for each band
-    std::vector<double> multiCellInterference; // Linear value (mW)
+    std::vector<double>& multiCellInterference = multiCellInterferenceBuffer_; // Linear value (mW)
     // prepare data structure
-    multiCellInterference.resize(numBands_, 0);
+    multiCellInterference.assign(numBands_, 0);
     if (enableDownlinkInterference_ && dir == DL) {
         computeDownlinkInterference(eNbId, bgUeId, ueCoord, isCqi, lteInfo->getCarrierFrequency(), rbmap, &multiCellInterference);
     }
@@ -1047,9 +1410,9 @@ std::vector<double> LteRealisticChannelModel::getSINR_bgUe(LteAirFrame *frame, U
 
     //============ BACKGROUND CELLS INTERFERENCE COMPUTATION =================
     //vector containing the sum of bg-cell interference for each band
-    std::vector<double> bgCellInterference; // Linear value (mW)
+    std::vector<double>& bgCellInterference = bgCellInterferenceBuffer_; // Linear value (mW)
     // prepare data structure
-    bgCellInterference.resize(numBands_, 0);
+    bgCellInterference.assign(numBands_, 0);
     if (enableBackgroundCellInterference_) {
         computeBackgroundCellInterference(bgUeId, enbCoord, ueCoord, isCqi, lteInfo->getCarrierFrequency(), rbmap, dir, &bgCellInterference); // dBm
     }
@@ -1057,9 +1420,9 @@ std::vector<double> LteRealisticChannelModel::getSINR_bgUe(LteAirFrame *frame, U
     //============ EXTCELL INTERFERENCE COMPUTATION =================
     // TODO this might be obsolete as it is replaced by background cell interference
     //vector containing the sum of ext-cell interference for each band
-    std::vector<double> extCellInterference; // Linear value (mW)
+    std::vector<double>& extCellInterference = extCellInterferenceBuffer_; // Linear value (mW)
     // prepare data structure
-    extCellInterference.resize(numBands_, 0);
+    extCellInterference.assign(numBands_, 0);
     if (enableExtCellInterference_ && dir == DL) {
         computeExtCellInterference(eNbId, bgUeId, ueCoord, isCqi, lteInfo->getCarrierFrequency(), &extCellInterference); // dBm
     }
@@ -1068,20 +1431,22 @@ std::vector<double> LteRealisticChannelModel::getSINR_bgUe(LteAirFrame *frame, U
     // compute and linearize total noise
     double totN = dBmToLinear(thermalNoise_ + noiseFigure);
 
+    // denominator expressed in dBm as (N+extCell+multiCell), converted for all the bands at once
+    std::vector<double>& den = denominatorBuffer_;
+    den.resize(numBands_);
+    for (unsigned int i = 0; i < numBands_; i++)
+        //       (      mW              +          mW            +  mW  +        mW            )
+        den[i] = bgCellInterference[i] + extCellInterference[i] + totN + multiCellInterference[i];
+    linearToDBm(den.data(), den.data(), numBands_, fastDbConversion_);
+
     // add interference for each band
     for (unsigned int i = 0; i < numBands_; i++) {
-        // denominator expressed in dBm as (N+extCell+multiCell)
-        //               (      mW              +          mW            +  mW  +        mW            )
-        double den = linearToDBm(bgCellInterference[i] + extCellInterference[i] + totN + multiCellInterference[i]);
-
         EV << "\t bgCell[" << bgCellInterference[i] << "] - ext[" << extCellInterference[i] << "] - multi[" << multiCellInterference[i] << "] - recvPwr["
-           << dBmToLinear(snrVector[i]) << "] - sinr[" << snrVector[i] - den << "]\n";
+           << dBmToLinear(snrVector[i]) << "] - sinr[" << snrVector[i] - den[i] << "]\n";
 
         // compute final SINR
-        snrVector[i] -= den;
+        snrVector[i] -= den[i];
     }
-
-    return snrVector;
 }
 
 double LteRealisticChannelModel::getReceivedPower_bgUe(double txPower, inet::Coord txPos, inet::Coord rxPos, Direction dir, bool losStatus, MacNodeId bsId)
@@ -1132,19 +1497,8 @@ double LteRealisticChannelModel::getReceivedPower_bgUe(double txPower, inet::Coo
             // get tx angle
             double txAngle = phy->getTxAngle();
 
-            // compute the angle between uePosition and reference axis, considering the eNb as center
-            double ueAngle = computeAngle(txPos, rxPos);
-
-            // compute the reception angle between ue and eNb
-            double recvAngle = fabs(txAngle - ueAngle);
-
-            if (recvAngle > 180)
-                recvAngle = 360 - recvAngle;
-
-            double verticalAngle = computeVerticalAngle(txPos, rxPos);
-
             // compute attenuation due to sectorial tx
-            double angularAtt = computeAngularAttenuation(recvAngle, verticalAngle);
+            double angularAtt = getAngularAttenuation(txPos, rxPos, txAngle);
 
             recvPower -= angularAtt;
         }
@@ -1230,6 +1584,10 @@ std::vector<double> LteRealisticChannelModel::getRSRP_D2D(LteAirFrame *frame, Us
     // if the phy layer is localized we can assume that for each logical band we have different fading attenuation
     // if the phy layer is distributed the number of logical band should be set to 1
     double fadingAttenuation = 0;
+    // compute Jakes fading for all the bands in one pass
+    std::vector<double> jakesFadingVector;
+    if (fading_ && fadingType_ == JAKES)
+        computeJakesFading(sourceId, speed, cqiDl, false, jakesFadingVector);
     //for each logical band
     for (unsigned int i = 0; i < numBands_; i++) {
         fadingAttenuation = 0;
@@ -1240,7 +1598,7 @@ std::vector<double> LteRealisticChannelModel::getRSRP_D2D(LteAirFrame *frame, Us
                 fadingAttenuation = rayleighFading(sourceId, i);
 
             else if (fadingType_ == JAKES) {
-                fadingAttenuation = jakesFading(sourceId, speed, i, cqiDl);
+                fadingAttenuation = jakesFadingVector[i];
             }
         }
         // add fading contribution to the received power
@@ -1267,6 +1625,13 @@ std::vector<double> LteRealisticChannelModel::getRSRP_D2D(LteAirFrame *frame, Us
 }
 
 std::vector<double> LteRealisticChannelModel::getSINR_D2D(LteAirFrame *frame, UserControlInfo *lteInfo, MacNodeId destId, Coord destCoord, MacNodeId enbId)
+{
+    std::vector<double> snrVector;
+    getSINR_D2D(frame, lteInfo, destId, destCoord, enbId, snrVector);
+    return snrVector;
+}
+
+void LteRealisticChannelModel::getSINR_D2D(LteAirFrame *frame, UserControlInfo *lteInfo, MacNodeId destId, Coord destCoord, MacNodeId enbId, std::vector<double>& snrVector)
 {
     // AttenuationVector::iterator it;
     // Get Tx power
@@ -1285,8 +1650,7 @@ std::vector<double> LteRealisticChannelModel::getSINR_D2D(LteAirFrame *frame, Us
     double extCellInterference = 0;
     // Get MacId for UE and his peer
     MacNodeId sourceId = lteInfo->getSourceId();
-    std::vector<double> snrVector;
-    snrVector.resize(numBands_, 0.0);
+    snrVector.assign(numBands_, 0.0);
 
     // True if we use the jakes map in the UE side (D2D is like DL for the receivers)
     bool cqiDl = true;
@@ -1337,6 +1701,10 @@ std::vector<double> LteRealisticChannelModel::getSINR_D2D(LteAirFrame *frame, Us
     // if the phy layer is localized we can assume that for each logical band we have different fading attenuation
     // if the phy layer is distributed the number of logical band should be set to 1
     double fadingAttenuation = 0;
+    // compute Jakes fading for all the bands in one pass
+    std::vector<double>& jakesFadingVector = jakesFadingBuffer_;
+    if (fading_ && fadingType_ == JAKES)
+        computeJakesFading(sourceId, speed, cqiDl, false, jakesFadingVector);
     //for each logical band
     for (unsigned int i = 0; i < numBands_; i++) {
         fadingAttenuation = 0;
@@ -1347,7 +1715,7 @@ std::vector<double> LteRealisticChannelModel::getSINR_D2D(LteAirFrame *frame, Us
                 fadingAttenuation = rayleighFading(sourceId, i);
 
             else if (fadingType_ == JAKES) {
-                fadingAttenuation = jakesFading(sourceId, speed, i, cqiDl);
+                fadingAttenuation = jakesFadingVector[i];
             }
         }
         // add fading contribution to the received power
@@ -1391,9 +1759,9 @@ std::vector<double> LteRealisticChannelModel::getSINR_D2D(LteAirFrame *frame, Us
      * is so we swap the ueId with the one of his Peer (D2D_Rx). We do the same for the coord.
      */
     //vector containing the sum of in-cell interference for each band
-    std::vector<double> d2dInterference; // Linear value (mW)
+    std::vector<double>& d2dInterference = d2dInterferenceBuffer_; // Linear value (mW)
     // prepare data structure
-    d2dInterference.resize(numBands_, 0);
+    d2dInterference.assign(numBands_, 0);
     if (enableD2DInterference_) {
         computeD2DInterference(enbId, sourceId, sourceCoord, destId, destCoord, (lteInfo->getFrameType() == FEEDBACKPKT), lteInfo->getCarrierFrequency(), rbmap, &d2dInterference, dir);
     }
@@ -1403,8 +1771,13 @@ std::vector<double> LteRealisticChannelModel::getSINR_D2D(LteAirFrame *frame, Us
         // compute and linearize total noise
         double totN = dBmToLinear(thermalNoise_ + noiseFigure);
 
-        // denominator expressed in dBm as (N+extCell+inCell)
-        double den;
+        // denominator expressed in dBm as (N+extCell+inCell), converted for all the bands at once
+        std::vector<double>& den = denominatorBuffer_;
+        den.resize(numBands_);
+        for (unsigned int i = 0; i < numBands_; i++)
+            //       (      mW            +  mW  +        mW            )
+            den[i] = extCellInterference + totN + d2dInterference[i];
+        linearToDBm(den.data(), den.data(), numBands_, fastDbConversion_);
         EV << "LteRealisticChannelModel::getSINR - distance from my Peer = " << destCoord.distance(sourceCoord) << " - DIR=" << dirToA(dir) << endl;
 
         // Add interference for each band
@@ -1414,14 +1787,11 @@ std::vector<double> LteRealisticChannelModel::getSINR_D2D(LteAirFrame *frame, Us
             if (lteInfo->getFrameType() == DATAPKT && rbmap[MACRO][i] == 0)
                 continue;
 
-            //               (      mW            +  mW  +        mW            )
-            den = linearToDBm(extCellInterference + totN + d2dInterference[i]);
-
             EV << "\t ext[" << extCellInterference << "] - in[" << d2dInterference[i] << "] - recvPwr["
-               << dBmToLinear(snrVector[i]) << "] - sinr[" << snrVector[i] - den << "]\n";
+               << dBmToLinear(snrVector[i]) << "] - sinr[" << snrVector[i] - den[i] << "]\n";
 
             // compute final SINR. Subtraction in dB is equivalent to linear division
-            snrVector[i] -= den;
+            snrVector[i] -= den[i];
         }
     }
     // compute snr with no D2D interference
@@ -1445,13 +1815,18 @@ std::vector<double> LteRealisticChannelModel::getSINR_D2D(LteAirFrame *frame, Us
     }
     //sender is a UE
     updatePositionHistory(sourceId, sourceCoord);
+}
 
+std::vector<double> LteRealisticChannelModel::getSINR_D2D(LteAirFrame *frame, UserControlInfo *lteInfo_1, MacNodeId destId, Coord destCoord, MacNodeId enbId, const std::vector<double>& rsrpVector)
+{
+    std::vector<double> snrVector;
+    getSINR_D2D(frame, lteInfo_1, destId, destCoord, enbId, rsrpVector, snrVector);
     return snrVector;
 }
 
-std::vector<double> LteRealisticChannelModel::getSINR_D2D(LteAirFrame *frame, UserControlInfo *lteInfo_1, MacNodeId destId, Coord destCoord, MacNodeId enbId, const std::vector<double>& rsrpVector)
+void LteRealisticChannelModel::getSINR_D2D(LteAirFrame *frame, UserControlInfo *lteInfo_1, MacNodeId destId, Coord destCoord, MacNodeId enbId, const std::vector<double>& rsrpVector, std::vector<double>& snrVector)
 {
-    std::vector<double> snrVector = rsrpVector;
+    snrVector = rsrpVector;
 
     MacNodeId sourceId = lteInfo_1->getSourceId();
     Coord sourceCoord = lteInfo_1->getCoord();
@@ -1491,9 +1866,9 @@ std::vector<double> LteRealisticChannelModel::getSINR_D2D(LteAirFrame *frame, Us
      * is so we swap the ueId with the one of his Peer (D2D_Rx). We do the same for the coord.
      */
     // vector containing the sum of inCell interference for each band
-    std::vector<double> d2dInterference; // Linear value (mW)
+    std::vector<double>& d2dInterference = d2dInterferenceBuffer_; // Linear value (mW)
     // prepare data structure
-    d2dInterference.resize(numBands_, 0);
+    d2dInterference.assign(numBands_, 0);
     if (enableD2DInterference_) {
         computeD2DInterference(enbId, sourceId, sourceCoord, destId, destCoord, (lteInfo_1->getFrameType() == FEEDBACKPKT), lteInfo_1->getCarrierFrequency(), rbmap, &d2dInterference, dir);
     }
@@ -1503,8 +1878,13 @@ std::vector<double> LteRealisticChannelModel::getSINR_D2D(LteAirFrame *frame, Us
         // compute and linearize total noise
         double totN = dBmToLinear(thermalNoise_ + noiseFigure);
 
-        // denominator expressed in dBm as (N+extCell+inCell)
-        double den;
+        // denominator expressed in dBm as (N+extCell+inCell), converted for all the bands at once
+        std::vector<double>& den = denominatorBuffer_;
+        den.resize(numBands_);
+        for (unsigned int i = 0; i < numBands_; i++)
+            //       (      mW            +  mW  +        mW            )
+            den[i] = extCellInterference + totN + d2dInterference[i];
+        linearToDBm(den.data(), den.data(), numBands_, fastDbConversion_);
         EV << "LteRealisticChannelModel::getSINR - distance from my Peer = " << destCoord.distance(sourceCoord) << " - DIR=" << dirToA(dir) << endl;
 
         // Add interference for each band
@@ -1514,14 +1894,11 @@ std::vector<double> LteRealisticChannelModel::getSINR_D2D(LteAirFrame *frame, Us
             if (lteInfo_1->getFrameType() == DATAPKT && rbmap[MACRO][i] == 0)
                 continue;
 
-            //               (      mW            +  mW  +        mW            )
-            den = linearToDBm(extCellInterference + totN + d2dInterference[i]);
-
             EV << "\t ext[" << extCellInterference << "] - in[" << d2dInterference[i] << "] - recvPwr["
-               << dBmToLinear(snrVector[i]) << "] - sinr[" << snrVector[i] - den << "]\n";
+               << dBmToLinear(snrVector[i]) << "] - sinr[" << snrVector[i] - den[i] << "]\n";
 
             // compute final SINR. Subtraction in dB is equivalent to linear division
-            snrVector[i] -= den;
+            snrVector[i] -= den[i];
         }
     }
     // compute snr with no D2D interference
@@ -1541,12 +1918,16 @@ std::vector<double> LteRealisticChannelModel::getSINR_D2D(LteAirFrame *frame, Us
 
     // sender is a UE
     updatePositionHistory(sourceId, sourceCoord);
+}
 
+std::vector<double> LteRealisticChannelModel::getSIR(LteAirFrame *frame, UserControlInfo *lteInfo)
+{
+    std::vector<double> snrVector;
+    getSIR(frame, lteInfo, snrVector);
     return snrVector;
 }
 
-std::vector<double> LteRealisticChannelModel::getSIR(LteAirFrame *frame,
-        UserControlInfo *lteInfo)
+void LteRealisticChannelModel::getSIR(LteAirFrame *frame, UserControlInfo *lteInfo, std::vector<double>& snrVector)
 {
     // AttenuationVector::iterator it;
     // get tx power
@@ -1580,9 +1961,13 @@ std::vector<double> LteRealisticChannelModel::getSIR(LteAirFrame *frame,
     // Apply fading for each band
     // if the phy layer is localized we can assume that for each logical band we have different fading attenuation
     // if the phy layer is distributed, the number of logical bands should be set to 1
-    std::vector<double> snrVector;
+    snrVector.clear();
 
     double fadingAttenuation = 0;
+    // compute Jakes fading for all the bands in one pass
+    std::vector<double>& jakesFadingVector = jakesFadingBuffer_;
+    if (fading_ && fadingType_ == JAKES)
+        computeJakesFading(id, speed, dir, false, jakesFadingVector);
     // for each logical band
     for (unsigned int i = 0; i < numBands_; i++) {
         fadingAttenuation = 0;
@@ -1593,7 +1978,7 @@ std::vector<double> LteRealisticChannelModel::getSIR(LteAirFrame *frame,
                 fadingAttenuation = rayleighFading(id, i);
             }
             else if (fadingType_ == JAKES) {
-                fadingAttenuation = jakesFading(id, speed, i, dir);
+                fadingAttenuation = jakesFadingVector[i];
             }
         }
         // add fading contribution to the final SINR
@@ -1609,7 +1994,6 @@ std::vector<double> LteRealisticChannelModel::getSIR(LteAirFrame *frame,
     // sender is a UE
     else
         updatePositionHistory(id, coord);
-    return snrVector;
 }
 
 double LteRealisticChannelModel::rayleighFading(MacNodeId id,
@@ -1621,8 +2005,7 @@ double LteRealisticChannelModel::rayleighFading(MacNodeId id,
     return linearToDb(temp1);
 }
 
-double LteRealisticChannelModel::jakesFading(MacNodeId nodeId, double speed,
-        unsigned int band, bool cqiDl, bool isBgUe)
+LteRealisticChannelModel::JakesFadingData& LteRealisticChannelModel::obtainJakesFadingData(MacNodeId nodeId, bool cqiDl, bool isBgUe)
 {
     /**
      * NOTE: there are two different Jakes maps. One on the UE side and one on the eNB side, with different values.
@@ -1642,59 +2025,54 @@ double LteRealisticChannelModel::jakesFading(MacNodeId nodeId, double speed,
     else
         actualJakesMap = &jakesFadingMap_;
 
-    // if this is the first time that we compute fading for current user
-    if (actualJakesMap->find(nodeId) == actualJakesMap->end()) {
-        // clear the map
-        // FIXME: possible memory leak
-        (*actualJakesMap)[nodeId].clear();
-
-        // for each band we are going to create a Jakes fading
-        for (unsigned int j = 0; j < numBands_; j++) {
-            // clear some structure
-            JakesFadingData temp;
-            temp.angleOfArrival.clear();
-            temp.delaySpread.clear();
-
-            // for each fading path
-            for (int i = 0; i < fadingPaths_; i++) {
-                // get angle of arrivals
-                temp.angleOfArrival.push_back(cos(uniform(0, M_PI)));
-
-                // get delay spread
-                temp.delaySpread.push_back(exponential(delayRMS_));
-            }
-            // store the Jakes fading for this user
-            (*actualJakesMap)[nodeId].push_back(temp);
+    auto it = actualJakesMap->find(nodeId);
+    if (it != actualJakesMap->end())
+        return it->second;
+
+    // this is the first time that we compute fading for current user
+    JakesFadingData& data = (*actualJakesMap)[nodeId];
+    data.angleOfArrival.resize(numBands_ * fadingPaths_);
+    data.delaySpread.resize(numBands_ * fadingPaths_);
+
+    // for each band we are going to create a Jakes fading
+    for (unsigned int j = 0; j < numBands_; j++) {
+        // for each fading path
+        for (int i = 0; i < fadingPaths_; i++) {
+            unsigned int k = j * fadingPaths_ + i;
+
+            // get angle of arrivals
+            data.angleOfArrival[k] = cos(uniform(0, M_PI));
+
+            // get delay spread (with the resolution of the simulation time)
+            data.delaySpread[k] = simtime_t(exponential(delayRMS_)).dbl();
         }
     }
-    // convert carrier frequency from GHz to Hz
+    return data;
+}
+
+double LteRealisticChannelModel::evaluateJakesFading(const JakesFadingData& data, unsigned int band, double dopplerShift, double t) const
+{
     double f = carrierFrequencyHz_;
 
-    // get transmission time start (TTI = 1ms)
-    simtime_t t = simTime().dbl() - 0.001;
+    // One ring model/Clarke's model plus f-selectivity according to Cavers:
+    // Due to isotropic antenna gain pattern on all paths only a^2 can be received on all paths.
+    // Since we are interested in attenuation a := 1, attenuation per path is then:
+    double attenuation = (1.00 / sqrt(static_cast<double>(fadingPaths_)));
+
+    const double *angleOfArrival = data.angleOfArrival.data() + band * fadingPaths_;
+    const double *delaySpread = data.delaySpread.data() + band * fadingPaths_;
 
     double re_h = 0;
     double im_h = 0;
-
-    const JakesFadingData& actualJakesData = actualJakesMap->at(nodeId).at(band);
-
-    // Compute Doppler shift.
-    double doppler_shift = (speed * f) / SPEED_OF_LIGHT;
-
     for (int i = 0; i < fadingPaths_; i++) {
         // Phase shift due to Doppler => t-selectivity.
-        double phi_d = actualJakesData.angleOfArrival[i] * doppler_shift;
+        double phi_d = angleOfArrival[i] * dopplerShift;
 
         // Phase shift due to delay spread => f-selectivity.
-        double phi_i = actualJakesData.delaySpread[i].dbl() * f;
+        double phi_i = delaySpread[i] * f;
 
         // Calculate resulting phase due to t-selective and f-selective fading.
-        double phi = 2.00 * M_PI * (phi_d * t.dbl() - phi_i);
-
-        // One ring model/Clarke's model plus f-selectivity according to Cavers:
-        // Due to isotropic antenna gain pattern on all paths only a^2 can be received on all paths.
-        // Since we are interested in attenuation a := 1, attenuation per path is then:
-        double attenuation = (1.00 / sqrt(static_cast<double>(fadingPaths_)));
+        double phi = 2.00 * M_PI * (phi_d * t - phi_i);
 
         // Convert to cartesian form and aggregate {Re, Im} over all fading paths.
         re_h = re_h + attenuation * cos(phi);
@@ -1706,18 +2084,90 @@ double LteRealisticChannelModel::jakesFading(MacNodeId nodeId, double speed,
     return linearToDb(re_h * re_h + im_h * im_h);
 }
 
+double LteRealisticChannelModel::jakesFading(MacNodeId nodeId, double speed,
+        unsigned int band, bool cqiDl, bool isBgUe)
+{
+    JakesFadingData& data = obtainJakesFadingData(nodeId, cqiDl, isBgUe);
+
+    // Compute Doppler shift.
+    double dopplerShift = (speed * carrierFrequencyHz_) / SPEED_OF_LIGHT;
+
+    if (enableJakesFadingCache_)
+        return getCachedJakesFading(data, dopplerShift)[band];
+
+    // get transmission time start (TTI = 1ms)
+    simtime_t t = simTime().dbl() - 0.001;
+
+    return evaluateJakesFading(data, band, dopplerShift, t.dbl());
+}
+
+void LteRealisticChannelModel::computeJakesFading(MacNodeId nodeId, double speed, bool cqiDl, bool isBgUe, std::vector<double>& fading)
+{
+    JakesFadingData& data = obtainJakesFadingData(nodeId, cqiDl, isBgUe);
+    double dopplerShift = (speed * carrierFrequencyHz_) / SPEED_OF_LIGHT;
+
+    if (enableJakesFadingCache_) {
+        fading = getCachedJakesFading(data, dopplerShift);
+        return;
+    }
+
+    // transmission time start (TTI = 1ms) and Doppler shift are the same for all the bands
+    simtime_t t = simTime().dbl() - 0.001;
+
+    fading.resize(numBands_);
+    for (unsigned int i = 0; i < numBands_; i++)
+        fading[i] = evaluateJakesFading(data, i, dopplerShift, t.dbl());
+}
+
+const std::vector<double>& LteRealisticChannelModel::getCachedJakesFading(JakesFadingData& data, double dopplerShift)
+{
+    if (!data.fading.empty()) {
+        // the fading only depends on time and Doppler shift: the same inputs give the same fading
+        if (NOW == data.fadingTime && dopplerShift == data.fadingDopplerShift)
+            return data.fading;
+
+        // the fading can be reused for a fraction of the coherence time (approximated as 0.423 / Doppler shift),
+        // computed with the larger of the old and the current Doppler shift. A static node sees a static channel
+        if (jakesFadingCacheCoherenceFraction_ > 0) {
+            double dopplerShiftBound = std::max(dopplerShift, data.fadingDopplerShift);
+            if ((NOW - data.fadingTime).dbl() * dopplerShiftBound < jakesFadingCacheCoherenceFraction_ * 0.423)
+                return data.fading;
+        }
+    }
+
+    simtime_t t = simTime().dbl() - 0.001;
+    data.fading.resize(numBands_);
+    for (unsigned int i = 0; i < numBands_; i++)
+        data.fading[i] = evaluateJakesFading(data, i, dopplerShift, t.dbl());
+    data.fadingTime = NOW;
+    data.fadingDopplerShift = dopplerShift;
+    return data.fading;
+}
+
 bool LteRealisticChannelModel::isReceptionSuccessful(LteAirFrame *frame, UserControlInfo *lteInfo)
 {
     EV << "LteRealisticChannelModel::error" << endl;
 
+    ReceptionEvaluation& reception = receptionEvaluation_;
+    reception.frame = frame;
+    reception.lteInfo = lteInfo;
+    reception.channelModel = this;
+
+    prepareReception(reception);
+    evaluateReception(reception);
+    return completeReception(reception);
+}
+
+void LteRealisticChannelModel::prepareReception(ReceptionEvaluation& reception)
+{
+    LteAirFrame *frame = reception.frame;
+    UserControlInfo *lteInfo = reception.lteInfo;
+
     // get codeword
     unsigned char cw = lteInfo->getCw();
     // get number of codewords
     int size = lteInfo->getUserTxParams()->readCqiVector().size();
 
-    // get position associated with the packet
-    // Coord coord = lteInfo->getCoord();
-
     // if total number of codewords is equal to 1 the cw index should be only 0
     if (size == 1)
         cw = 0;
@@ -1725,15 +2175,8 @@ bool LteRealisticChannelModel::isReceptionSuccessful(LteAirFrame *frame, UserCon
     // get cqi used to transmit this cw
     Cqi cqi = lteInfo->getUserTxParams()->readCqiVector()[cw];
 
-    MacNodeId id;
     Direction dir = (Direction)lteInfo->getDirection();
 
-    // Get MacNodeId of UE
-    if (dir == DL)
-        id = lteInfo->getDestId();
-    else
-        id = lteInfo->getSourceId();
-
     // Get Number of transmission attempts (includes original + retransmissions)
     unsigned char transmissionAttempt = lteInfo->getTxNumber();
 
@@ -1745,104 +2188,130 @@ bool LteRealisticChannelModel::isReceptionSuccessful(LteAirFrame *frame, UserCon
     TxMode txmode = (TxMode)lteInfo->getTxMode();
 
     // Take sinr
-    std::vector<double> snrV;
+    std::vector<double>& snrV = reception.sinr;
     if (lteInfo->getDirection() == D2D || lteInfo->getDirection() == D2D_MULTI) {
         MacNodeId destId = lteInfo->getDestId();
         Coord destCoord = phy_->getCoord();
         MacNodeId enbId = binder_->getNextHop(lteInfo->getSourceId());
-        snrV = getSINR_D2D(frame, lteInfo, destId, destCoord, enbId);
+        getSINR_D2D(frame, lteInfo, destId, destCoord, enbId, snrV);
     }
     else {
-        snrV = getSINR(frame, lteInfo);
+        getSINR(frame, lteInfo, snrV);
     }
 
     // Get the resource Block id used to transmit this packet
-    RbMap rbmap = lteInfo->getGrantedBlocks();
-
-    // Get txmode
-    unsigned int itxmode = txModeToIndex[txmode];
-
-    double blockErrorRate = 0.0;
-    double cumulativeSuccessProbability = 1.0;
+    reception.rbmap = lteInfo->getGrantedBlocks();
+    reception.cqi = cqi;
+    reception.txModeIndex = txModeToIndex[txmode];
+    reception.transmissionAttempt = transmissionAttempt;
+    reception.phyPisaData = &binder_->phyPisaData;
+    reception.decided = false;
+    reception.result = false;
 
     // for statistical purposes
-    double sumSnr = 0.0;
-    int usedRBs = 0;
+    reception.sumSnr = 0.0;
+    reception.usedRBs = 0;
+
+    int minSnr = reception.phyPisaData->minSnr();
 
     // for each Remote unit used to transmit the packet
-    for (const auto &[remoteUnit, rbList] : rbmap) {
+    for (const auto &[remoteUnit, rbList] : reception.rbmap) {
         // for each logical band used to transmit the packet
         for (const auto &[band, allocation] : rbList) {
             // this Rb is not allocated
             if (allocation == 0)
                 continue;
 
-            // Get the Bler
             if (cqi == 0 || cqi > 15)
                 throw cRuntimeError("A packet has been transmitted with a cqi equal to 0 or greater than 15 cqi:%d txmode:%d dir:%d rb:%d cw:%d rtx:%d", cqi, lteInfo->getTxMode(), dir, band, cw, transmissionAttempt);
 
             // for statistical purposes
-            sumSnr += snrV[band];
-            usedRBs++;
+            reception.sumSnr += snrV[band];
+            reception.usedRBs++;
 
             int snr = snrV[band];// XXX because band is a Band (=unsigned short)
-            if (snr < binder_->phyPisaData.minSnr())
-                return false;
-            else if (snr > binder_->phyPisaData.maxSnr())
-                blockErrorRate = 0.0;
-            else
-                blockErrorRate = binder_->phyPisaData.getBler(itxmode, cqi - 1, snr);
 
-            EV << "\t bler computation: [itxMode=" << itxmode << "] - [cqi-1=" << cqi - 1
-               << "] - [snr=" << snr << "]" << endl;
+            EV << "\t bler computation: [itxMode=" << reception.txModeIndex << "] - [cqi-1=" << cqi - 1
+               << "] - [snr=" << snr << "] - remote unit " << dasToA(remoteUnit) << " band " << band << endl;
 
-            double blockSuccessRate = 1.0 - blockErrorRate;
-            // compute the success probability according to the number of RB used
-            double allocationSuccessProbability = pow(blockSuccessRate, (double)allocation);
-            // compute the success probability according to the number of LB used
-            cumulativeSuccessProbability *= allocationSuccessProbability;
+            // the frame cannot be received, and no random number is extracted
+            if (snr < minSnr) {
+                reception.decided = true;
+                return;
+            }
+        }
+    }
 
-            EV << " LteRealisticChannelModel::error direction " << dirToA(dir)
-               << " node " << id << " remote unit " << dasToA(remoteUnit)
-               << " Band " << band << " SNR " << snr << " CQI " << cqi
-               << " BLER " << blockErrorRate << " success probability " << allocationSuccessProbability
-               << " total success probability " << cumulativeSuccessProbability << endl;
+    reception.randomSample = uniform(0.0, 1.0);
+}
+
+void LteRealisticChannelModel::evaluateReception(ReceptionEvaluation& reception) const
+{
+    if (reception.decided)
+        return;
+
+    PhyPisaData *phyPisaData = reception.phyPisaData;
+    int maxSnr = phyPisaData->maxSnr();
+
+    // the success probability is accumulated in the log domain, i.e. sum(allocation * log(1-bler)),
+    // so that a single exp() replaces one pow() per band
+    double logSuccessProbability = 0.0;
+
+    for (const auto &[remoteUnit, rbList] : reception.rbmap) {
+        for (const auto &[band, allocation] : rbList) {
+            if (allocation == 0)
+                continue;
+
+            int snr = reception.sinr[band];
+            double blockErrorRate = (snr > maxSnr) ? 0.0 : phyPisaData->getBler(reception.txModeIndex, reception.cqi - 1, snr);
+
+            // compute the success probability according to the number of RB used
+            if (blockErrorRate != 0.0)
+                logSuccessProbability += allocation * log1p(-blockErrorRate);
         }
     }
     // Compute total error probability
-    double packetErrorRate = 1.0 - cumulativeSuccessProbability;
+    reception.packetErrorRate = 1.0 - exp(logSuccessProbability);
     // Apply HARQ soft combining gain
-    double effectiveErrorRateWithHarq = packetErrorRate * pow(harqReduction_, transmissionAttempt - 1);
+    reception.errorRate = reception.packetErrorRate * pow(harqReduction_, reception.transmissionAttempt - 1);
+}
 
-    double randomSample = uniform(0.0, 1.0);
+bool LteRealisticChannelModel::completeReception(ReceptionEvaluation& reception)
+{
+    if (reception.decided)
+        return reception.result;
+
+    UserControlInfo *lteInfo = reception.lteInfo;
+    Direction dir = (Direction)lteInfo->getDirection();
+    MacNodeId id = (dir == DL) ? lteInfo->getDestId() : lteInfo->getSourceId();
 
     EV << " LteRealisticChannelModel::error direction " << dirToA(dir)
-       << " node " << id << " total ERROR probability  " << packetErrorRate
-       << " per with H-ARQ error reduction " << effectiveErrorRateWithHarq
-       << " - CQI[" << cqi << "]- random error extracted[" << randomSample << "]" << endl;
+       << " node " << id << " total ERROR probability  " << reception.packetErrorRate
+       << " per with H-ARQ error reduction " << reception.errorRate
+       << " - CQI[" << reception.cqi << "]- random error extracted[" << reception.randomSample << "]" << endl;
 
     // emit SINR statistic
-    if (collectSinrStatistics_ && usedRBs > 0) {
+    if (collectSinrStatistics_ && reception.usedRBs > 0) {
         if (dir == DL) // we are on the UE
-            emit(rcvdSinrDlSignal_, sumSnr / usedRBs);
+            emit(rcvdSinrDlSignal_, reception.sumSnr / reception.usedRBs);
         else {
             // we are on the BS, so we need to retrieve the channel model of the sender
             // XXX I know, there might be a faster way...
             LteChannelModel *ueChannelModel = check_and_cast<LtePhyUe *>(binder_->getPhyByNodeId(id))->getChannelModel(lteInfo->getCarrierFrequency());
-            ueChannelModel->emit(rcvdSinrUlSignal_, sumSnr / usedRBs);
+            ueChannelModel->emit(rcvdSinrUlSignal_, reception.sumSnr / reception.usedRBs);
         }
     }
 
-    bool receptionFailed = (randomSample <= effectiveErrorRateWithHarq);
+    bool receptionFailed = (reception.randomSample <= reception.errorRate);
     if (receptionFailed) {
-        EV << "This is NOT your lucky day (" << randomSample << " < " << effectiveErrorRateWithHarq
+        EV << "This is NOT your lucky day (" << reception.randomSample << " < " << reception.errorRate
            << ") -> do not receive." << endl;
 
         // Signal too weak, we can't receive it
         return false;
     }
     // Signal is strong enough, receive this Signal
-    EV << "This is your lucky day (" << randomSample << " > " << effectiveErrorRateWithHarq
+    EV << "This is your lucky day (" << reception.randomSample << " > " << reception.errorRate
        << ") -> Receive AirFrame." << endl;
 
     return true;
@@ -1889,21 +2358,21 @@ bool LteRealisticChannelModel::isReceptionSuccessful_D2D(LteAirFrame *frame, Use
     TxMode txmode = (TxMode)lteInfo->getTxMode();
 
     // SINR vector(one SINR value for each band)
-    std::vector<double> snrV;
+    std::vector<double>& snrV = receptionSinrBuffer_;
     if (lteInfo->getDirection() == D2D || lteInfo->getDirection() == D2D_MULTI) {
         MacNodeId peerUeMacNodeId = lteInfo->getDestId();
         Coord peerCoord = phy_->getCoord();
         MacNodeId enbId = MacNodeId(1); // TODO get an appropriate way to get EnbId
 
         if (lteInfo->getDirection() == D2D) {
-            snrV = getSINR_D2D(frame, lteInfo, peerUeMacNodeId, peerCoord, enbId);
+            getSINR_D2D(frame, lteInfo, peerUeMacNodeId, peerCoord, enbId, snrV);
         }
         else { // D2D_MULTI
-            snrV = getSINR_D2D(frame, lteInfo, peerUeMacNodeId, peerCoord, enbId, rsrpVector);
+            getSINR_D2D(frame, lteInfo, peerUeMacNodeId, peerCoord, enbId, rsrpVector, snrV);
         }
     }
     // ROSSALI-------END------------------------------------------------
-    else snrV = getSINR(frame, lteInfo);                                           // Take SINR
+    else getSINR(frame, lteInfo, snrV);                                           // Take SINR
 
     // Get the resource Block id used to transmit this packet
     RbMap rbmap = lteInfo->getGrantedBlocks();
@@ -1913,7 +2382,8 @@ bool LteRealisticChannelModel::isReceptionSuccessful_D2D(LteAirFrame *frame, Use
 
     double bler = 0;
     std::vector<double> totalbler;
-    double finalSuccess = 1;
+    // success probability accumulated in the log domain (see isReceptionSuccessful)
+    double logFinalSuccess = 0;
 
     // for statistical purposes
     double sumSnr = 0.0;
@@ -1945,20 +2415,20 @@ bool LteRealisticChannelModel::isReceptionSuccessful_D2D(LteAirFrame *frame, Use
             EV << "\t bler computation: [itxMode=" << itxmode << "] - [cqi-1=" << cqi - 1
                << "] - [snr=" << snr << "]" << endl;
 
-            double success = 1 - bler;
             // compute the success probability according to the number of RB used
-            double successPacket = pow(success, (double)allocation);
+            double logSuccessPacket = (bler == 0) ? 0 : allocation * log1p(-bler);
 
             // compute the success probability according to the number of LB used
-            finalSuccess *= successPacket;
+            logFinalSuccess += logSuccessPacket;
 
             EV << " LteRealisticChannelModel::error direction " << dirToA(dir)
                << " node " << id << " remote unit " << dasToA(remoteUnitId)
                << " Band " << band << " SNR " << snr << " CQI " << cqi
-               << " BLER " << bler << " success probability " << successPacket
-               << " total success probability " << finalSuccess << endl;
+               << " BLER " << bler << " success probability " << exp(logSuccessPacket)
+               << " total success probability " << exp(logFinalSuccess) << endl;
         }
     }
+    double finalSuccess = exp(logFinalSuccess);
     // Compute total error probability
     double per = 1 - finalSuccess;
     // Harq Reduction
@@ -1992,7 +2462,7 @@ void LteRealisticChannelModel::computeLosProbability(double d,
 {
     double p = 0;
     if (!dynamicLos_) {
-        losMap_[nodeId] = fixedLos_;
+        losState(nodeId) = fixedLos_;
         return;
     }
     switch (scenario_) {
@@ -2029,9 +2499,9 @@ void LteRealisticChannelModel::computeLosProbability(double d,
     }
     double random = uniform(0.0, 1.0);
     if (random <= p)
-        losMap_[nodeId] = true;
+        losState(nodeId) = true;
     else
-        losMap_[nodeId] = false;
+        losState(nodeId) = false;
 }
 
 double LteRealisticChannelModel::computePathLoss(double distance, double dbp, bool los)
@@ -2248,18 +2718,18 @@ double LteRealisticChannelModel::getStdDev(bool dist, MacNodeId nodeId)
     switch (scenario_) {
         case URBAN_MICROCELL:
         case INDOOR_HOTSPOT:
-            if (losMap_[nodeId])
+            if (losState(nodeId))
                 return 3.;
             else
                 return 4.;
         case URBAN_MACROCELL:
-            if (losMap_[nodeId])
+            if (losState(nodeId))
                 return 4.;
             else
                 return 6.;
         case RURAL_MACROCELL:
         case SUBURBAN_MACROCELL:
-            if (losMap_[nodeId]) {
+            if (losState(nodeId)) {
                 if (dist)
                     return 4.;
                 else
@@ -2279,75 +2749,93 @@ bool LteRealisticChannelModel::computeExtCellInterference(MacNodeId eNbId, MacNo
     EV << "**** Ext Cell Interference **** " << endl;
 
     // get external cell list
-    ExtCellList list = binder_->getExtCellList(carrierFrequency);
-
-    double dist, // meters
-           recvPwr, // watt
-           recvPwrDBm, // dBm
-           att, // dBm
-           angularAtt; // dBm
+    const ExtCellList& list = binder_->getExtCellList(carrierFrequency);
+    if (list.empty())
+        return true;
 
-    //compute distance for each cell
-    for (auto& extCell : list) {
-        // get external cell position
-        Coord c = extCell->getPosition();
-        // compute distance between UE and the ext cell
-        dist = coord.distance(c);
-
-        EV << "\t distance between UE[" << coord.x << "," << coord.y <<
-            "] and extCell[" << c.x << "," << c.y << "] is -> "
-           << dist << "\t";
-
-        // compute attenuation according to some path loss model
-        att = computeExtCellPathLoss(dist, nodeId);
-
-        //=============== ANGULAR ATTENUATION =================
-        if (extCell->getTxDirection() == OMNI) {
-            angularAtt = 0;
-        }
-        else {
-            // compute the angle between uePosition and reference axis, considering the eNb as center
-            double ueAngle = computeAngle(c, coord);
+    const std::vector<double>& recvPwr = getExtCellReceivedPowers(nodeId, coord, list);
 
-            // compute the reception angle between ue and eNb
-            double recvAngle = fabs(extCell->getTxAngle() - ueAngle);
+    // add interference in those bands where the ext cell is active. The band status is either 0 or 1,
+    // hence the received power is added to every shared band, multiplied by the band status
+    double *interf = interference->data();
+    for (unsigned int k = 0; k < list.size(); k++) {
+        ExtCell *extCell = list[k];
+        unsigned int numBands = std::min(numBands_, extCell->getNumBands());
 
-            if (recvAngle > 180)
-                recvAngle = 360 - recvAngle;
+        // check slot occupation for this TTI, or for the previous TTI for the error computation
+        const int *occ = isCqi ? extCell->getBandStatus().data() : extCell->getPrevBandStatus().data();
+        double pwr = recvPwr[k];
+        for (unsigned int i = 0; i < numBands; i++)
+            interf[i] += occ[i] * pwr;
+    }
 
-            double verticalAngle = computeVerticalAngle(c, coord);
+    return true;
+}
 
-            // compute attenuation due to sectorial tx
-            angularAtt = computeAngularAttenuation(recvAngle, verticalAngle);
+const std::vector<double>& LteRealisticChannelModel::getExtCellReceivedPowers(MacNodeId nodeId, const Coord& coord, const ExtCellList& list)
+{
+    bool los = false;
+    double shadowing = 0.0;
+    if (enableExtCellInterferenceCache_) {
+        // the path loss depends on the LOS state and the shadowing of the node, besides its position
+        los = losState(nodeId);
+        NodeChannelState& state = obtainNodeState(nodeId);
+        shadowing = state.hasShadowing ? state.shadowing : 0.0;
+        if (state.hasExtCellPowers && state.extCellPowers.size() == list.size() && state.extCellPowersLos == los
+            && state.extCellPowersShadowing == shadowing && state.extCellPowersCoord.distance(coord) <= extCellInterferenceCacheDistance_)
+        {
+            EV << "\t reusing the power received from the external cells at [" << state.extCellPowersCoord.x << "," << state.extCellPowersCoord.y << "]" << endl;
+            return state.extCellPowers;
         }
-        //=============== END ANGULAR ATTENUATION =================
+    }
 
-        // TODO do we need to use (- cableLoss_ + antennaGainEnB_) in ext cells too?
-        // compute and linearize received power
-        recvPwrDBm = extCell->getTxPower() - att - angularAtt - cableLoss_ + antennaGainEnB_ + antennaGainUe_;
-        recvPwr = dBmToLinear(recvPwrDBm);
+    std::vector<double>& recvPwr = extCellPowerBuffer_;
+    recvPwr.resize(list.size());
+    for (unsigned int k = 0; k < list.size(); k++)
+        recvPwr[k] = computeExtCellReceivedPower(list[k], nodeId, coord);
+    dBmToLinear(recvPwr.data(), recvPwr.data(), recvPwr.size(), fastDbConversion_);
 
-        unsigned int numBands = std::min(numBands_, extCell->getNumBands());
-        EV << " - shared bands [" << numBands << "]" << endl;
+    if (!enableExtCellInterferenceCache_)
+        return recvPwr;
 
-        // add interference in those bands where the ext cell is active
-        for (unsigned int i = 0; i < numBands; i++) {
-            int occ;
-            if (isCqi) { // check slot occupation for this TTI
-                occ = extCell->getBandStatus(i);
-            }
-            else {      // error computation. We need to check the slot occupation of the previous TTI
-                occ = extCell->getPrevBandStatus(i);
-            }
+    NodeChannelState& state = obtainNodeState(nodeId);
+    state.hasExtCellPowers = true;
+    state.extCellPowersCoord = coord;
+    state.extCellPowersLos = los;
+    state.extCellPowersShadowing = shadowing;
+    state.extCellPowers = recvPwr;
+    return state.extCellPowers;
+}
 
-            // if the ext cell is active, add interference
-            if (occ) {
-                (*interference)[i] += recvPwr;
-            }
-        }
+double LteRealisticChannelModel::computeExtCellReceivedPower(ExtCell *extCell, MacNodeId nodeId, const Coord& coord)
+{
+    // get external cell position
+    Coord c = extCell->getPosition();
+    // compute distance between UE and the ext cell
+    double dist = coord.distance(c);
+
+    EV << "\t distance between UE[" << coord.x << "," << coord.y <<
+        "] and extCell[" << c.x << "," << c.y << "] is -> "
+       << dist << "\t";
+
+    // compute attenuation according to some path loss model
+    double att = computeExtCellPathLoss(dist, nodeId);
+
+    //=============== ANGULAR ATTENUATION =================
+    double angularAtt;
+    if (extCell->getTxDirection() == OMNI) {
+        angularAtt = 0;
+    }
+    else {
+        // compute attenuation due to sectorial tx
+        angularAtt = getAngularAttenuation(c, coord, extCell->getTxAngle());
     }
+    //=============== END ANGULAR ATTENUATION =================
 
-    return true;
+    EV << " - shared bands [" << std::min(numBands_, extCell->getNumBands()) << "]" << endl;
+
+    // TODO do we need to use (- cableLoss_ + antennaGainEnB_) in ext cells too?
+    return extCell->getTxPower() - att - angularAtt - cableLoss_ + antennaGainEnB_ + antennaGainUe_;
 }
 
 bool LteRealisticChannelModel::computeBackgroundCellInterference(MacNodeId nodeId, inet::Coord bsCoord, inet::Coord ueCoord, bool isCqi, GHz carrierFrequency, const RbMap& rbmap, Direction dir,
@@ -2390,19 +2878,8 @@ bool LteRealisticChannelModel::computeBackgroundCellInterference(MacNodeId nodeI
                 angularAtt = 0;
             }
             else {
-                // compute the angle between uePosition and reference axis, considering the eNB as center
-                double ueAngle = computeAngle(c, ueCoord);
-
-                // compute the reception angle between ue and eNB
-                double recvAngle = fabs(bgScheduler->getTxAngle() - ueAngle);
-
-                if (recvAngle > 180)
-                    recvAngle = 360 - recvAngle;
-
-                double verticalAngle = computeVerticalAngle(c, ueCoord);
-
                 // compute attenuation due to sectorial tx
-                angularAtt = computeAngularAttenuation(recvAngle, verticalAngle);
+                angularAtt = getAngularAttenuation(c, ueCoord, bgScheduler->getTxAngle());
             }
             //=============== END ANGULAR ATTENUATION =================
 
@@ -2487,11 +2964,20 @@ bool LteRealisticChannelModel::computeBackgroundCellInterference(MacNodeId nodeI
     return true;
 }
 
+void LteRealisticChannelModel::addInterferingPowers(std::vector<double> *interference)
+{
+    unsigned int n = interferingPowers_.size();
+    dBmToLinear(interferingPowers_.data(), interferingPowers_.data(), n, fastDbConversion_);
+    // contributions are added in the same order they have been gathered
+    for (unsigned int k = 0; k < n; k++)
+        (*interference)[interferingBands_[k]] += interferingPowers_[k];
+}
+
 double LteRealisticChannelModel::computeExtCellPathLoss(double dist, MacNodeId nodeId)
 {
 
     //compute attenuation based on selected scenario and based on LOS or NLOS
-    bool los = losMap_[nodeId];
+    bool los = losState(nodeId);
 
     if (!enable_extCell_los_)
         los = false;
@@ -2546,49 +3032,24 @@ double LteRealisticChannelModel::computeExtCellPathLoss(double dist, MacNodeId n
 
 LteRealisticChannelModel::JakesFadingMap *LteRealisticChannelModel::obtainUeJakesMap(MacNodeId id)
 {
-    // obtain a reference to UE phy
-    LtePhyBase *phy = nullptr;
-
-    for (const auto& ueInfo : binder_->getUeList()) {
-        if (ueInfo->id == id) {
-            phy = ueInfo->phy;
-            break;
-        }
-    }
-
-    if (phy == nullptr)
-        return nullptr;
-
-    // get the associated channel and get a reference to its Jakes Map
-    JakesFadingMap *j;
-    LteRealisticChannelModel *re = dynamic_cast<LteRealisticChannelModel *>(phy->getChannelModel(carrierFrequency_));
-    if (re == nullptr)
+    // get the channel model of the UE on this carrier and get a reference to its Jakes Map
+    LteRealisticChannelModel *re = binder_->getUeRealisticChannelModel(id, carrierFrequency_);
+    if (re == nullptr) {
+        // UE not found
+        if (binder_->getUeInfo(id) == nullptr || binder_->getUeInfo(id)->phy == nullptr)
+            return nullptr;
         throw cRuntimeError("LteRealisticChannelModel::obtainUeJakesMap - channel model is a null pointer");
-    else
-        j = re->getJakesMap();
-
-    return j;
+    }
+    return re->getJakesMap();
 }
 
-LteRealisticChannelModel::ShadowFadingMap *LteRealisticChannelModel::obtainShadowingMap(MacNodeId id)
+LteRealisticChannelModel::NodeChannelState *LteRealisticChannelModel::obtainUeNodeState(MacNodeId id)
 {
-    // obtain a reference to UE phy
-    LtePhyBase *phy = nullptr;
-
-    for (const auto& ueInfo : binder_->getUeList()) {
-        if (ueInfo->id == id) {
-            phy = ueInfo->phy;
-            break;
-        }
-    }
-
-    if (phy == nullptr)
+    // get the channel model of the UE on this carrier and get a reference to its state for the UE
+    LteRealisticChannelModel *re = binder_->getUeRealisticChannelModel(id, carrierFrequency_);
+    if (re == nullptr)
         return nullptr;
-
-    // get the associated channel and get a reference to its shadowing Map
-    LteRealisticChannelModel *re = dynamic_cast<LteRealisticChannelModel *>(phy->getChannelModel(carrierFrequency_));
-    ShadowFadingMap *j = re->getShadowingMap();
-    return j;
+    return &re->obtainNodeState(id);
 }
 
 bool LteRealisticChannelModel::computeDownlinkInterference(MacNodeId eNbId, MacNodeId ueId, Coord coord, bool isCqi, GHz carrierFrequency, const RbMap& rbmap,
@@ -2603,60 +3064,21 @@ bool LteRealisticChannelModel::computeDownlinkInterference(MacNodeId eNbId, MacN
         if (id == eNbId)
             continue;
 
-        // initialize eNB data structures
-        if (!enbInfo->init) {
-            // obtain a reference to eNB phy and obtain tx power
-            enbInfo->phy = check_and_cast<LtePhyBase *>(binder_->getPhyByNodeId(id));
-
-            enbInfo->txPwr = enbInfo->phy->getTxPwr();//dBm
-
-            // get tx direction
-            enbInfo->txDirection = enbInfo->phy->getTxDirection();
-
-            // get tx angle
-            enbInfo->txAngle = enbInfo->phy->getTxAngle();
-
-            //get reference to mac layer
-            enbInfo->mac = check_and_cast<LteMacEnb *>(binder_->getMacByNodeId(id));
-
-            enbInfo->init = true;
-        }
-
-        LteRealisticChannelModel *interfChanModel = dynamic_cast<LteRealisticChannelModel *>(enbInfo->phy->getChannelModel(carrierFrequency));
+        // get the channel model of the eNB and the received power, except for path loss and shadowing
+        const InterfererLinkBudget& linkBudget = getInterfererLinkBudget(enbInfo, coord, carrierFrequency);
+        LteRealisticChannelModel *interfChanModel = linkBudget.chanModel;
 
         // if the eNB does not use the selected carrier frequency, skip it
         if (interfChanModel == nullptr)
             continue;
 
         // compute attenuation using data structures within the cell
-        double att = interfChanModel->getAttenuation(ueId, UL, coord, isCqi);
+        double att = interfChanModel->getCachedAttenuation(ueId, UL, coord, isCqi);
         EV << "EnbId [" << id << "] - attenuation [" << att << "]";
 
-        //=============== ANGULAR ATTENUATION =================
-        double angularAtt = 0;
-        if (enbInfo->txDirection == ANISOTROPIC) {
-            //get tx angle
-            double txAngle = enbInfo->txAngle;
-
-            // compute the angle between uePosition and reference axis, considering the eNB as center
-            double ueAngle = computeAngle(interfChanModel->phy_->getCoord(), coord);
-
-            // compute the reception angle between ue and eNB
-            double recvAngle = fabs(txAngle - ueAngle);
-            if (recvAngle > 180)
-                recvAngle = 360 - recvAngle;
-
-            double verticalAngle = computeVerticalAngle(interfChanModel->phy_->getCoord(), coord);
-
-            // compute attenuation due to sectorial tx
-            angularAtt = computeAngularAttenuation(recvAngle, verticalAngle);
-
-            EV << "angular attenuation [" << angularAtt << "]";
-        }
-        // else, antenna is omni-directional
-        //=============== END ANGULAR ATTENUATION =================
-
-        double txPwr = enbInfo->txPwr - angularAtt - cableLoss_ + antennaGainEnB_ + antennaGainUe_;
+        double txPwr = linkBudget.txPwr;
+        // received power is the same on all the bands, linearize it once
+        double recvPwr = dBmToLinear(txPwr - att); //(dBm-dB)=dBm
 
         unsigned int numBands = std::min(numBands_, interfChanModel->getNumBands());
         EV << " - shared bands [" << numBands << "]" << endl;
@@ -2666,7 +3088,7 @@ bool LteRealisticChannelModel::computeDownlinkInterference(MacNodeId eNbId, MacN
                 // compute the number of occupied slot (unnecessary)
                 int temp = enbInfo->mac->getDlBandStatus(i);
                 if (temp != 0)
-                    (*interference)[i] += dBmToLinear(txPwr - att); //(dBm-dB)=dBm
+                    (*interference)[i] += recvPwr;
 
                 EV << "\t band " << i << " occupied " << temp << "/pwr[" << txPwr << "]-int[" << (*interference)[i] << "]" << endl;
             }
@@ -2681,7 +3103,7 @@ bool LteRealisticChannelModel::computeDownlinkInterference(MacNodeId eNbId, MacN
                 // compute the number of occupied slot (unnecessary)
                 int temp = enbInfo->mac->getDlPrevBandStatus(i);
                 if (temp != 0)
-                    (*interference)[i] += dBmToLinear(txPwr - att); //(dBm-dB)=dBm
+                    (*interference)[i] += recvPwr;
 
                 EV << "\t band " << i << " occupied " << temp << "/pwr[" << txPwr << "]-int[" << (*interference)[i] << "]" << endl;
             }
@@ -2695,13 +3117,18 @@ bool LteRealisticChannelModel::computeUplinkInterference(MacNodeId eNbId, MacNod
 {
     EV << "**** Uplink Interference for cellId[" << eNbId << "] node[" << senderId << "] ****" << endl;
 
-    const std::vector<std::vector<UeAllocationInfo>> *ulTransmissionMap;
+    const UlTransmissionMap *ulTransmissionMap;
     const std::vector<UeAllocationInfo> *allocatedUes;
 
+    // received powers are gathered in dBm and linearized all at once
+    interferingBands_.clear();
+    interferingPowers_.clear();
+
     if (isCqi) {// check slot occupation for this TTI
         ulTransmissionMap = binder_->getUlTransmissionMap(carrierFrequency, CURR_TTI);
-        if (ulTransmissionMap != nullptr && !ulTransmissionMap->empty()) {
-            for (unsigned int i = 0; i < numBands_; i++) {
+        if (ulTransmissionMap != nullptr) {
+            // only the bands used by at least one UE are checked
+            for (unsigned int i = ulTransmissionMap->nextOccupiedBand(0); i < numBands_; i = ulTransmissionMap->nextOccupiedBand(i + 1)) {
                 // get the set of UEs transmitting on the same band
                 allocatedUes = &(ulTransmissionMap->at(i));
 
@@ -2736,19 +3163,21 @@ bool LteRealisticChannelModel::computeUplinkInterference(MacNodeId eNbId, MacNod
 
                     // get rx power and attenuation from this UE
                     double rxPwr = txPwr - cableLoss_ + antennaGainUe_ + antennaGainEnB_;
-                    double att = getAttenuation(ueId, UL, ueCoord, false);
-                    (*interference)[i] += dBmToLinear(rxPwr - att);//(dBm-dB)=dBm
+                    double att = getCachedAttenuation(ueId, UL, ueCoord, false);
+                    interferingBands_.push_back(i);
+                    interferingPowers_.push_back(rxPwr - att);//(dBm-dB)=dBm
 
-                    EV << "\t band " << i << "/pwr[" << rxPwr - att << "]-int[" << (*interference)[i] << "]" << endl;
+                    EV << "\t band " << i << "/pwr[" << rxPwr - att << "]" << endl;
                 }
             }
         }
     }
     else { // Error computation. We need to check the slot occupation of the previous TTI
         ulTransmissionMap = binder_->getUlTransmissionMap(carrierFrequency, PREV_TTI);
-        if (ulTransmissionMap != nullptr && !ulTransmissionMap->empty()) {
+        if (ulTransmissionMap != nullptr) {
             // For each band we have to check if the Band in the previous TTI was occupied by the interferingId
-            for (unsigned int i = 0; i < numBands_; i++) {
+            // only the bands used by at least one UE are checked
+            for (unsigned int i = ulTransmissionMap->nextOccupiedBand(0); i < numBands_; i = ulTransmissionMap->nextOccupiedBand(i + 1)) {
                 // if we are decoding a data transmission and this RB has not been used, skip it
                 // TODO fix for multi-antenna case
                 if (!rbmap.empty() && rbmap.at(MACRO).at(i) == 0)
@@ -2788,15 +3217,18 @@ bool LteRealisticChannelModel::computeUplinkInterference(MacNodeId eNbId, MacNod
 
                     // get tx power and attenuation from this UE
                     double rxPwr = txPwr - cableLoss_ + antennaGainUe_ + antennaGainEnB_;
-                    double att = getAttenuation(ueId, UL, ueCoord, false);
-                    (*interference)[i] += dBmToLinear(rxPwr - att);//(dBm-dB)=dBm
+                    double att = getCachedAttenuation(ueId, UL, ueCoord, false);
+                    interferingBands_.push_back(i);
+                    interferingPowers_.push_back(rxPwr - att);//(dBm-dB)=dBm
 
-                    EV << "\t band " << i << "/pwr[" << rxPwr - att << "]-int[" << (*interference)[i] << "]" << endl;
+                    EV << "\t band " << i << "/pwr[" << rxPwr - att << "]" << endl;
                 }
             }
         }
     }
 
+    addInterferingPowers(interference);
+
     // Debug Output
     EV << NOW << " LteRealisticChannelModel::computeUplinkInterference - Final Band Interference Status: " << endl;
     for (unsigned int i = 0; i < numBands_; i++)
@@ -2813,13 +3245,18 @@ bool LteRealisticChannelModel::computeD2DInterference(MacNodeId eNbId, MacNodeId
     // get the reference to the MAC of the eNodeB
     LteMacEnbD2D *macEnb = check_and_cast<LteMacEnbD2D *>(binder_->getMacFromMacNodeId(eNbId));
 
-    const std::vector<std::vector<UeAllocationInfo>> *ulTransmissionMap;
+    const UlTransmissionMap *ulTransmissionMap;
     const std::vector<UeAllocationInfo> *allocatedUes;
 
+    // received powers are gathered in dBm and linearized all at once
+    interferingBands_.clear();
+    interferingPowers_.clear();
+
     if (isCqi) {// check slot occupation for this TTI
         ulTransmissionMap = binder_->getUlTransmissionMap(carrierFrequency, CURR_TTI);
-        if (ulTransmissionMap != nullptr && !ulTransmissionMap->empty()) {
-            for (unsigned int i = 0; i < numBands_; i++) {
+        if (ulTransmissionMap != nullptr) {
+            // only the bands used by at least one UE are checked
+            for (unsigned int i = ulTransmissionMap->nextOccupiedBand(0); i < numBands_; i = ulTransmissionMap->nextOccupiedBand(i + 1)) {
                 // get the UEs transmitting on the same band
                 allocatedUes = &(ulTransmissionMap->at(i));
 
@@ -2859,18 +3296,20 @@ bool LteRealisticChannelModel::computeD2DInterference(MacNodeId eNbId, MacNodeId
                     // get tx power and attenuation from this UE
                     double rxPwr = txPwr - cableLoss_ + 2 * antennaGainUe_;
                     double att = getAttenuation_D2D(ueId, D2D, ueCoord, destId, destCoord, false);
-                    (*interference)[i] += dBmToLinear(rxPwr - att);//(dBm-dB)=dBm
+                    interferingBands_.push_back(i);
+                    interferingPowers_.push_back(rxPwr - att);//(dBm-dB)=dBm
 
-                    EV << "\t band " << i << "/pwr[" << rxPwr - att << "]-int[" << (*interference)[i] << "]" << endl;
+                    EV << "\t band " << i << "/pwr[" << rxPwr - att << "]" << endl;
                 }
             }
         }
     }
     else { // Error computation. We need to check the slot occupation of the previous TTI
         ulTransmissionMap = binder_->getUlTransmissionMap(carrierFrequency, PREV_TTI);
-        if (ulTransmissionMap != nullptr && !ulTransmissionMap->empty()) {
+        if (ulTransmissionMap != nullptr) {
             // For each band we have to check if the Band in the previous TTI was occupied by the interferingId
-            for (unsigned int i = 0; i < numBands_; i++) {
+            // only the bands used by at least one UE are checked
+            for (unsigned int i = ulTransmissionMap->nextOccupiedBand(0); i < numBands_; i = ulTransmissionMap->nextOccupiedBand(i + 1)) {
                 // get the UEs transmitting on the same band
                 allocatedUes = &(ulTransmissionMap->at(i));
 
@@ -2910,14 +3349,17 @@ bool LteRealisticChannelModel::computeD2DInterference(MacNodeId eNbId, MacNodeId
                     // get tx power and attenuation from this UE
                     double rxPwr = txPwr - cableLoss_ + 2 * antennaGainUe_;
                     double att = getAttenuation_D2D(ueId, D2D, ueCoord, destId, destCoord, false);
-                    (*interference)[i] += dBmToLinear(rxPwr - att);//(dBm-dB)=dBm
+                    interferingBands_.push_back(i);
+                    interferingPowers_.push_back(rxPwr - att);//(dBm-dB)=dBm
 
-                    EV << "\t band " << i << "/pwr[" << rxPwr - att << "]-int[" << (*interference)[i] << "]" << endl;
+                    EV << "\t band " << i << "/pwr[" << rxPwr - att << "]" << endl;
                 }
             }
         }
     }
 
+    addInterferingPowers(interference);
+
     // Debug Output
     EV << NOW << " LteRealisticChannelModel::computeD2DInterference - Final Band Interference Status: " << endl;
     for (unsigned int i = 0; i < numBands_; i++)
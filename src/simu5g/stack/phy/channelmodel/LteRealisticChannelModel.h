@@ -13,6 +13,8 @@
 #ifndef STACK_PHY_CHANNELMODEL_LTEREALISTICCHANNELMODEL_H_
 #define STACK_PHY_CHANNELMODEL_LTEREALISTICCHANNELMODEL_H_
 
+#include <tuple>
+
 #include "simu5g/common/LteDefs.h"
 #include "simu5g/stack/phy/channelmodel/LteChannelModel.h"
 
@@ -86,22 +88,69 @@ class LteRealisticChannelModel : public LteChannelModel
 
     typedef std::pair<inet::simtime_t, inet::Coord> Position;
 
-    // Last position of current user
-    std::map<MacNodeId, std::queue<Position>> positionHistory_;
+    /*
+     * Fixed-capacity ring of the last positions of a user
+     */
+    struct PositionHistory
+    {
+        static constexpr unsigned int CAPACITY = 2;    // a past and a current element
+        Position positions[CAPACITY];
+        unsigned int first = 0;
+        unsigned int size = 0;
+
+        const Position& front() const { return positions[first]; }
+        const Position& back() const { return positions[(first + size - 1) % CAPACITY]; }
+
+        // appends the position, dropping the oldest one if the ring is full
+        void push(const Position& position)
+        {
+            if (size < CAPACITY)
+                positions[(first + size++) % CAPACITY] = position;
+            else {
+                positions[first] = position;
+                first = (first + 1) % CAPACITY;
+            }
+        }
+    };
 
-    // Last position of current user at which probability of LOS was computed.
-    std::map<MacNodeId, Position> lastCorrelationPoint_;
+    /*
+     * Channel state of a user, as seen by this channel model
+     */
+    struct NodeChannelState
+    {
+        // Last positions of the user
+        PositionHistory positionHistory;
+
+        // Last position of the user at which probability of LOS was computed
+        bool hasCorrelationPoint = false;
+        Position lastCorrelationPoint;
+
+        // Whether the user is in Line of Sight or not with eNodeB
+        bool hasLos = false;
+        bool los = false;
+
+        // Last computed shadowing for the user and its temporal mark
+        bool hasShadowing = false;
+        inet::simtime_t shadowingTime;
+        double shadowing = 0.0;
+
+        // Power received by the user from each external cell (linear), along with the position,
+        // LOS state and shadowing it has been computed with (see the extCellInterferenceCache parameter)
+        bool hasExtCellPowers = false;
+        inet::Coord extCellPowersCoord;
+        bool extCellPowersLos = false;
+        double extCellPowersShadowing = 0.0;
+        std::vector<double> extCellPowers;
+    };
+
+    // Dense index of the users' channel state: nodeStateIndex_[num(nodeId)] is the position
+    // of the state of nodeId in nodeStates_, plus one (0 if there is no state for nodeId)
+    std::vector<unsigned short> nodeStateIndex_;
+    std::vector<NodeChannelState> nodeStates_;
 
     // Scenario
     DeploymentScenario scenario_;
 
-    // Map that stores for each user if is in Line of Sight or not with eNodeB
-    std::map<MacNodeId, bool> losMap_;
-
-    // Stores the last computed shadowing for each user
-    typedef std::map<MacNodeId, std::pair<inet::simtime_t, double>> ShadowFadingMap;
-    ShadowFadingMap lastComputedSF_;
-
     // Correlation distance used in shadowing computation and
     // also used to recompute the probability of LOS
     double correlationDistance_;
@@ -141,21 +190,27 @@ class LteRealisticChannelModel : public LteChannelModel
 
     bool tolerateMaxDistViolation_;
 
-    // Struct used to store information about Jakes fading
+    // Struct used to store information about Jakes fading of one node.
+    // Data are stored as a structure of arrays: the entry for (band, path) is at
+    // index band * fadingPaths_ + path, so that all the bands can be evaluated in one pass
     struct JakesFadingData
     {
-        std::vector<double> angleOfArrival;
-        std::vector<simtime_t> delaySpread;
+        std::vector<double> angleOfArrival; // cosine of the angle of arrival
+        std::vector<double> delaySpread;    // delay spread (s)
+
+        // fading of all the bands computed last (see the jakesFadingCache parameter)
+        std::vector<double> fading;
+        simtime_t fadingTime;               // time the fading was computed at
+        double fadingDopplerShift = 0;      // Doppler shift the fading was computed with
     };
 
-    // For each node and for each band we store information about Jakes fading
-    std::map<MacNodeId, std::vector<JakesFadingData>> jakesFadingMap_;
+    typedef std::map<MacNodeId, JakesFadingData> JakesFadingMap;
 
-    // For each node and for each band we store information about Jakes fading
-    std::map<MacNodeId, std::vector<JakesFadingData>> jakesFadingMapBgUe_;
+    // For each node we store information about Jakes fading for all the bands
+    JakesFadingMap jakesFadingMap_;
 
-    typedef std::vector<JakesFadingData> JakesFadingVector;
-    typedef std::map<MacNodeId, JakesFadingVector> JakesFadingMap;
+    // For each node we store information about Jakes fading for all the bands
+    JakesFadingMap jakesFadingMapBgUe_;
 
     enum FadingType
     {
@@ -174,6 +229,109 @@ class LteRealisticChannelModel : public LteChannelModel
     // If false, disable the collection of SINR statistics, which might be quite time-consuming
     bool collectSinrStatistics_;
 
+    // Enable or disable the per-TTI cache of the attenuation of interfering links
+    bool enableAttenuationCache_;
+
+    // Attenuation (path loss + shadowing) computed for a link in the current TTI.
+    // The entry is valid as long as the position of both ends is unchanged
+    struct AttenuationCacheEntry
+    {
+        inet::Coord rxCoord;
+        inet::Coord txCoord;
+        double attenuation;
+    };
+
+    // For each (node, direction, cqiDl flag), stores the last computed attenuation.
+    // The receiving node and the carrier are implicit, as there is one channel model per PHY and carrier
+    typedef std::tuple<MacNodeId, Direction, bool> AttenuationCacheKey;
+    std::map<AttenuationCacheKey, AttenuationCacheEntry> attenuationCache_;
+    // time the entries of attenuationCache_ refer to. The map is cleared when the time advances
+    simtime_t attenuationCacheTime_;
+
+    // Feedback SINR cache (see the feedbackSinrCache parameter)
+    bool enableFeedbackSinrCache_;
+    // distance either end of the link or an interfering UE must move to invalidate the cached sinr
+    double feedbackSinrCacheDistance_;
+    // maximum lifetime of a cached sinr
+    simtime_t feedbackSinrCacheMaxAge_;
+
+    // SINR computed for the last feedback of a UE in one direction
+    struct FeedbackSinrCacheEntry
+    {
+        simtime_t expiration;   // the entry is valid until this time (fading coherence time)
+        inet::Coord ueCoord;
+        inet::Coord enbCoord;
+        double txPower;
+        uint64_t interferenceSignature; // hash of the band usage of the interferers, see computeInterferenceSignature()
+        std::vector<double> sinr;
+    };
+    std::map<std::pair<MacNodeId, Direction>, FeedbackSinrCacheEntry> feedbackSinrCache_;
+    // number of cached sinrs reused and recomputed (i.e., an entry existed but was no longer valid), for DL and UL
+    unsigned int numFeedbackSinrCacheHits_[2] = { 0, 0 };
+    unsigned int numFeedbackSinrCacheRefreshes_[2] = { 0, 0 };
+    // if true, finish() raises an error if the cached sinrs of one direction were recomputed but never reused
+    bool checkFeedbackSinrCacheHits_;
+
+    // Jakes fading cache (see the jakesFadingCache parameter)
+    bool enableJakesFadingCache_;
+    // fraction of the coherence time during which a computed fading is reused (0 = same time instant only)
+    double jakesFadingCacheCoherenceFraction_;
+
+    // External cell interference cache: the power received from the external cells is reused until
+    // the UE moves by more than extCellInterferenceCacheDistance_ (see the extCellInterferenceCache parameter)
+    bool enableExtCellInterferenceCache_;
+    double extCellInterferenceCacheDistance_;
+
+    // Link budget: deterministic terms of the links towards the other nodes, kept until either end
+    // of the link moves by more than linkBudgetRefreshDistance_ (see the linkBudget parameter)
+    bool enableLinkBudget_;
+    double linkBudgetRefreshDistance_;
+
+    // Path loss between this node and another node
+    struct LinkBudgetEntry
+    {
+        bool valid = false;
+        inet::Coord rxCoord; // position of this node when the entry was computed
+        inet::Coord txCoord; // position of the other node when the entry was computed
+        double pathLoss[2];  // path loss in NLOS [0] and LOS [1] conditions, NaN if not computed yet
+    };
+    // indexed by the MacNodeId of the other node
+    std::vector<LinkBudgetEntry> linkBudget_;
+
+    // Received power from an interfering eNB, without path loss and shadowing
+    struct InterfererLinkBudget
+    {
+        bool valid = false;
+        inet::Coord rxCoord; // position of the receiver when the entry was computed
+        LteRealisticChannelModel *chanModel = nullptr; // channel model of the eNB (nullptr if it does not use this carrier)
+        double txPwr = 0;    // dBm, including antenna gains, cable loss and angular attenuation
+    };
+    // indexed by the MacNodeId of the eNB
+    std::vector<InterfererLinkBudget> interfererLinkBudget_;
+    // used when the link budget is disabled
+    InterfererLinkBudget interfererLinkBudgetScratch_;
+
+    // If true, the per-band dB/linear conversions use fast approximations (see LteCommon.h)
+    bool fastDbConversion_;
+
+    // If true, the attenuation due to the antenna pattern is looked up in precomputed tables
+    bool antennaPatternTables_;
+    // number of intervals the tables are made of
+    unsigned int antennaPatternTableSize_;
+    // horizontal attenuation, sampled uniformly in the cosine of the angle from the boresight direction in [-1,1]
+    std::vector<double> hPatternTable_;
+    // vertical attenuation, sampled uniformly in the cosine of the angle from the horizontal plane in [0,1]
+    std::vector<double> vPatternTable_;
+    // maximum attenuation of the antenna pattern
+    double maxAngularAtt_;
+    // cosine and sine of the boresight directions of the transmitters, indexed by tx angle
+    std::map<double, std::pair<double, double>> boresightDirections_;
+
+    // Received powers (dBm) from interfering UEs and the bands they interfere on, gathered by
+    // computeUplinkInterference() and computeD2DInterference() and linearized all at once
+    std::vector<unsigned int> interferingBands_;
+    std::vector<double> interferingPowers_;
+
     // Statistics
     static simsignal_t rcvdSinrDlSignal_;
     static simsignal_t rcvdSinrUlSignal_;
@@ -183,6 +341,7 @@ class LteRealisticChannelModel : public LteChannelModel
 
   public:
     void initialize(int stage) override;
+    void finish() override;
 
     /*
      * Compute Attenuation caused by pathloss and shadowing (optional)
@@ -227,6 +386,22 @@ class LteRealisticChannelModel : public LteChannelModel
      */
     virtual double computeAngularAttenuation(double hAngle, double vAngle = 0);
 
+    /*
+     * Compute the attenuation caused by the antenna pattern of an anisotropic transmitter.
+     * If antenna pattern tables are enabled, the attenuation is looked up in tables built
+     * from computeAngularAttenuation(), otherwise it is computed by the latter
+     *
+     * @param txCoord position of the transmitter
+     * @param rxCoord position of the receiver
+     * @param txAngle boresight direction of the transmitter (degrees)
+     */
+    double getAngularAttenuation(const Coord& txCoord, const Coord& rxCoord, double txAngle);
+
+    /*
+     * Build the antenna pattern tables used by getAngularAttenuation()
+     */
+    void initAntennaPatternTables();
+
     /*
      * Compute shadowing
      *
@@ -243,6 +418,7 @@ class LteRealisticChannelModel : public LteChannelModel
      * @param lteinfo pointer to the user control info
      */
     std::vector<double> getSIR(LteAirFrame *frame, UserControlInfo *lteInfo) override;
+    void getSIR(LteAirFrame *frame, UserControlInfo *lteInfo, std::vector<double>& snrVector) override;
 
     /*
      * Compute sinr for each band for user nodeId according to pathloss, shadowing (optional) and multipath fading
@@ -251,6 +427,27 @@ class LteRealisticChannelModel : public LteChannelModel
      * @param lteinfo pointer to the user control info
      */
     std::vector<double> getSINR(LteAirFrame *frame, UserControlInfo *lteInfo) override;
+    void getSINR(LteAirFrame *frame, UserControlInfo *lteInfo, std::vector<double>& snrVector) override;
+
+    /*
+     * Compute the sinr averaged over all the bands.
+     * The per-band sinr is computed by getSINR() into a scratch buffer, so that no vector
+     * is allocated for every handover broadcast
+     *
+     * @param frame pointer to the packet
+     * @param lteinfo pointer to the user control info
+     */
+    double getWidebandSINR(LteAirFrame *frame, UserControlInfo *lteInfo) override;
+
+    /*
+     * Compute the sinr for the feedback of a UE. If the feedback SINR cache is enabled, the sinr
+     * computed for the previous feedback is returned if neither the UE nor the eNB moved, the
+     * interferers are using the same bands and the fading coherence time has not elapsed
+     *
+     * @param frame pointer to the packet
+     * @param lteinfo pointer to the user control info
+     */
+    void getFeedbackSINR(LteAirFrame *frame, UserControlInfo *lteInfo, std::vector<double>& snrVector) override;
 
     /*
      * Compute received useful signal for each band for user nodeId according to pathloss, shadowing (optional) and multipath fading
@@ -259,6 +456,8 @@ class LteRealisticChannelModel : public LteChannelModel
      * @param lteinfo pointer to the user control info
      */
     std::vector<double> getRSRP(LteAirFrame *frame, UserControlInfo *lteInfo) override;
+    void getRSRP(LteAirFrame *frame, UserControlInfo *lteInfo, std::vector<double>& rsrpVector) override;
+    double queryRsrp(MacNodeId txNode, double txPower, const inet::Coord& txCoord, MacNodeId rxNode, GHz carrierFrequency) override;
 
     /*
      * Compute sinr for each band for a background UE according to pathloss
@@ -267,6 +466,7 @@ class LteRealisticChannelModel : public LteChannelModel
      * @param lteinfo pointer to the user control info
      */
     std::vector<double> getSINR_bgUe(LteAirFrame *frame, UserControlInfo *lteInfo) override;
+    void getSINR_bgUe(LteAirFrame *frame, UserControlInfo *lteInfo, std::vector<double>& snrVector) override;
 
     /*
      * Compute received power for a background UE according to pathloss
@@ -287,6 +487,8 @@ class LteRealisticChannelModel : public LteChannelModel
      */
     std::vector<double> getSINR_D2D(LteAirFrame *frame, UserControlInfo *lteInfo_1, MacNodeId destId, inet::Coord destCoord, MacNodeId enbId) override;
     std::vector<double> getSINR_D2D(LteAirFrame *frame, UserControlInfo *lteInfo_1, MacNodeId destId, inet::Coord destCoord, MacNodeId enbId, const std::vector<double>& rsrpVector) override;
+    void getSINR_D2D(LteAirFrame *frame, UserControlInfo *lteInfo_1, MacNodeId destId, inet::Coord destCoord, MacNodeId enbId, std::vector<double>& snrVector) override;
+    void getSINR_D2D(LteAirFrame *frame, UserControlInfo *lteInfo_1, MacNodeId destId, inet::Coord destCoord, MacNodeId enbId, const std::vector<double>& rsrpVector, std::vector<double>& snrVector) override;
 
     /*
      * Compute the error probability of the transmitted packet according to cqi used, txmode, and the received power
@@ -307,6 +509,13 @@ class LteRealisticChannelModel : public LteChannelModel
      */
     bool isReceptionSuccessful(LteAirFrame *frame, UserControlInfo *lteI) override;
 
+    /*
+     * Stages of isReceptionSuccessful(), see LteChannelModel::ReceptionEvaluation
+     */
+    void prepareReception(ReceptionEvaluation& reception) override;
+    void evaluateReception(ReceptionEvaluation& reception) const override;
+    bool completeReception(ReceptionEvaluation& reception) override;
+
     /*
      * Compute the path-loss attenuation according to the selected scenario
      *
@@ -382,6 +591,17 @@ class LteRealisticChannelModel : public LteChannelModel
      */
     double jakesFading(MacNodeId nodeId, double speed, unsigned int band, bool cqiDl, bool isBgUe = false);
 
+    /*
+     * Compute Jakes fading for all the logical bands in one pass
+     *
+     * @param nodeid mac node id of UE
+     * @param speed speed of UE
+     * @param cqiDl if true, the jakesMap in the UE side should be used
+     * @param isBgUe if true, this is called for a background UE
+     * @param fading output vector, resized to the number of bands
+     */
+    void computeJakesFading(MacNodeId nodeId, double speed, bool cqiDl, bool isBgUe, std::vector<double>& fading);
+
     /*
      * Compute LOS probability
      *
@@ -395,16 +615,43 @@ class LteRealisticChannelModel : public LteChannelModel
         return &jakesFadingMap_;
     }
 
-    ShadowFadingMap *getShadowingMap()
-    {
-        return &lastComputedSF_;
-    }
-
     bool isUplinkInterferenceEnabled() override { return enableUplinkInterference_; }
     bool isD2DInterferenceEnabled() override { return enableD2DInterference_; }
 
   protected:
 
+    /*
+     * Same as getAttenuation(), but the result is reused for all calls referring to the
+     * same link within the same TTI, as long as neither end has moved.
+     * Used by the interference computation, which evaluates the same link on every band
+     */
+    double getCachedAttenuation(MacNodeId nodeId, Direction dir, inet::Coord coord, bool cqiDl);
+
+    /*
+     * Returns the slot of the link budget storing the path loss between this node and nodeId, located
+     * at coord, in the given LOS condition. The slot is NaN if the path loss must be computed (and stored).
+     * Returns nullptr if the link budget is disabled or not available for nodeId
+     */
+    double *getLinkBudgetPathLoss(MacNodeId nodeId, const inet::Coord& coord, bool los);
+
+    /*
+     * Returns the channel model of the given interfering eNB and the power received from it
+     * at coord, excluding path loss and shadowing
+     */
+    const InterfererLinkBudget& getInterfererLinkBudget(EnbInfo *enbInfo, const inet::Coord& coord, GHz carrierFrequency);
+
+    /*
+     * Returns a hash of the inputs of the interference computation for a CQI, i.e., the bands
+     * used by the interfering eNBs, UEs and external cells (and the positions of the interfering UEs,
+     * quantized to feedbackSinrCacheDistance_)
+     */
+    uint64_t computeInterferenceSignature(MacNodeId eNbId, Direction dir, GHz carrierFrequency);
+
+    /*
+     * Emits the average sinr measured for a feedback on the channel model of the UE
+     */
+    void emitMeasuredSinr(MacNodeId ueId, Direction dir, GHz carrierFrequency, double sinr);
+
     /*
      * Returns the 2D distance between two coordinates (ignore z-axis)
      */
@@ -435,6 +682,42 @@ class LteRealisticChannelModel : public LteChannelModel
      */
     void updatePositionHistory(const MacNodeId nodeId, const inet::Coord coord);
 
+    /*
+     * Returns the channel state of the given node, creating it if it does not exist
+     * (references are invalidated by the creation of the state of another node)
+     * @param nodeid mac node id of UE
+     */
+    NodeChannelState& obtainNodeState(const MacNodeId nodeId);
+
+    /*
+     * Returns the channel state of the given node, or nullptr if it does not exist
+     */
+    NodeChannelState *findNodeState(const MacNodeId nodeId)
+    {
+        unsigned short index = num(nodeId) < nodeStateIndex_.size() ? nodeStateIndex_[num(nodeId)] : 0;
+        return index != 0 ? &nodeStates_[index - 1] : nullptr;
+    }
+
+    /*
+     * Returns true if the LOS state of the given node has been computed
+     */
+    bool hasLosState(const MacNodeId nodeId)
+    {
+        NodeChannelState *state = findNodeState(nodeId);
+        return state != nullptr && state->hasLos;
+    }
+
+    /*
+     * Returns the LOS state of the given node. A node whose LOS state
+     * has not been computed yet is considered in NLOS
+     */
+    bool& losState(const MacNodeId nodeId)
+    {
+        NodeChannelState& state = obtainNodeState(nodeId);
+        state.hasLos = true;
+        return state.los;
+    }
+
     /*
      * Compute total interference due to eNB coexistence for the DL direction
      * @param eNbId id of the considered eNb
@@ -452,11 +735,40 @@ class LteRealisticChannelModel : public LteChannelModel
      */
     bool computeD2DInterference(MacNodeId eNbId, MacNodeId senderId, inet::Coord senderCoord, MacNodeId destId, inet::Coord destCoord, bool isCqi, GHz carrierFrequency, const RbMap& rbmap, std::vector<double> *interference, Direction dir);
 
+    /*
+     * Compute the received signal for each band, for the transmission between UE ueId and eNB eNbId
+     * (used by getRSRP() and queryRsrp())
+     *
+     * @param dir direction of the transmission
+     * @param feedback true if the received signal is computed for the feedback of the UE
+     * @param txPower transmission power (dBm)
+     * @param coord position of the sender (of the UE if feedback is true)
+     */
+    virtual void computeRSRP(MacNodeId ueId, MacNodeId eNbId, Direction dir, bool feedback, double txPower, const inet::Coord& coord, std::vector<double>& rsrpVector);
+
+    /*
+     * Linearizes the powers gathered in interferingPowers_ and adds them to the interference
+     * of the corresponding bands
+     */
+    void addInterferingPowers(std::vector<double> *interference);
+
     /*
      * Evaluates total interference from external cells seen from the spot given by coord
      * @return total interference expressed in dBm
      */
-    virtual bool computeExtCellInterference(MacNodeId eNbId, MacNodeId nodeId, inet::Coord coord, bool isCqi, GHz carrierFrequency, std::vector<double> *interference);
+    bool computeExtCellInterference(MacNodeId eNbId, MacNodeId nodeId, inet::Coord coord, bool isCqi, GHz carrierFrequency, std::vector<double> *interference);
+
+    /*
+     * Returns the power (linear) received at the spot given by coord from each external cell in the list,
+     * which is either computed or retrieved from the state of nodeId
+     */
+    const std::vector<double>& getExtCellReceivedPowers(MacNodeId nodeId, const inet::Coord& coord, const ExtCellList& list);
+
+    /*
+     * Computes the power received at the spot given by coord from the given external cell
+     * @return received power expressed in dBm
+     */
+    virtual double computeExtCellReceivedPower(ExtCell *extCell, MacNodeId nodeId, const inet::Coord& coord);
 
     /*
      * Evaluates total interference from external cells seen from the spot given by coord
@@ -470,6 +782,42 @@ class LteRealisticChannelModel : public LteChannelModel
      */
     double computeExtCellPathLoss(double dist, MacNodeId nodeId);
 
+    /*
+     * Return the Jakes fading data of the given node, creating them on first use
+     */
+    JakesFadingData& obtainJakesFadingData(MacNodeId nodeId, bool cqiDl, bool isBgUe);
+
+    /*
+     * Return the fading of all the bands for the given Jakes fading data and Doppler shift,
+     * served from the cache of the data when still valid (see the jakesFadingCache parameter)
+     */
+    const std::vector<double>& getCachedJakesFading(JakesFadingData& data, double dopplerShift);
+
+    /*
+     * Evaluate the Jakes fading of one band, given the Doppler shift of the node
+     * and the start time of the transmission
+     */
+    double evaluateJakesFading(const JakesFadingData& data, unsigned int band, double dopplerShift, double t) const;
+
+    /*
+     * Scratch buffers for the per-band values computed by getSINR() and similar functions,
+     * reused across calls to avoid allocating new vectors for every packet
+     */
+    std::vector<double> jakesFadingBuffer_;
+    std::vector<double> multiCellInterferenceBuffer_;
+    std::vector<double> bgCellInterferenceBuffer_;
+    std::vector<double> extCellInterferenceBuffer_;
+    std::vector<double> extCellPowerBuffer_;
+    std::vector<double> rsrpQueryBuffer_;
+    std::vector<double> d2dInterferenceBuffer_;
+    std::vector<double> denominatorBuffer_;
+    // SINR of the packet being decoded by isReceptionSuccessful_D2D()
+    std::vector<double> receptionSinrBuffer_;
+    // per-band SINR averaged by getWidebandSINR()
+    std::vector<double> widebandSinrBuffer_;
+    // state of the packet being decoded by isReceptionSuccessful()
+    ReceptionEvaluation receptionEvaluation_;
+
     /*
      * Obtain the jakes map for the specified UE
      * @param id mac id of the user
@@ -478,10 +826,11 @@ class LteRealisticChannelModel : public LteChannelModel
     JakesFadingMap *obtainUeJakesMap_bgUe(MacNodeId id);
 
     /*
-     * Obtain the shadowing map for the specified UE
+     * Obtain the channel state stored by the channel model of the specified UE
+     * (which holds its shadowing for the DL direction)
      * @param id mac id of the user
      */
-    ShadowFadingMap *obtainShadowingMap(MacNodeId id);
+    NodeChannelState *obtainUeNodeState(MacNodeId id);
 };
 
 } //namespace
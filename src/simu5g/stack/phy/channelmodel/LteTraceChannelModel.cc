@@ -0,0 +1,353 @@
+//
+//                  Simu5G
+//
+// Copyright (C) 2022-2026 Giovanni Nardini, Giovanni Stea et al. (University of Pisa)
+//
+// This file is part of a software released under the license included in file
+// "license.pdf". Please read LICENSE and README files before using it.
+// The above files and the present reference are part of the software itself,
+// and cannot be removed from it.
+//
+
+#include "simu5g/stack/phy/channelmodel/LteTraceChannelModel.h"
+
+#include <cstring>
+
+#include "simu5g/common/InitStages.h"
+#include "simu5g/common/LteCommon.h"
+
+namespace simu5g {
+
+Define_Module(LteTraceChannelModel);
+
+using namespace omnetpp;
+
+const char LteTraceChannelModel::traceMagic_[8] = { 'S', '5', 'G', 'C', 'H', 'T', 'R', '\0' };
+
+void LteTraceChannelModel::initialize(int stage)
+{
+    LteRealisticChannelModel::initialize(stage);
+
+    if (stage == inet::INITSTAGE_LOCAL) {
+        std::string mode = par("traceMode").stdstringValue();
+        if (mode == "record")
+            traceMode_ = TRACE_RECORD;
+        else if (mode == "replay")
+            traceMode_ = TRACE_REPLAY;
+        else
+            throw cRuntimeError("LteTraceChannelModel::initialize - unknown trace mode '%s'", mode.c_str());
+
+        traceFileName_ = par("traceFile").stdstringValue();
+        replayFallback_ = par("replayFallback");
+        verifyTrace_ = par("verifyTrace");
+
+        WATCH(numTraceHits_);
+        WATCH(numTraceMisses_);
+        WATCH(numTraceRecords_);
+        WATCH(numUnreplayedRecords_);
+    }
+    else if (stage == INITSTAGE_SIMU5G_POSTLOCAL) {
+        // the number of bands is known from this stage on
+        openTrace();
+    }
+}
+
+void LteTraceChannelModel::finish()
+{
+    LteRealisticChannelModel::finish();
+
+    if (traceMode_ == TRACE_REPLAY && verifyTrace_)
+        verifyReplayedTrace();
+
+    if (traceFile_.is_open())
+        traceFile_.close();
+
+    if (traceMode_ == TRACE_RECORD && verifyTrace_)
+        verifyRecordedTrace();
+}
+
+void LteTraceChannelModel::hashRecord(uint64_t& hash, const TraceRecordHeader& record, const double *values)
+{
+    auto mix = [&hash](const void *data, size_t size) {
+        const unsigned char *bytes = static_cast<const unsigned char *>(data);
+        for (size_t i = 0; i < size; i++)
+            hash = (hash ^ bytes[i]) * 1099511628211ULL;
+    };
+    mix(&record.time, sizeof(record.time));
+    uint64_t key = getTraceKey(record);
+    mix(&key, sizeof(key));
+    mix(&record.size, sizeof(record.size));
+    mix(values, record.size * sizeof(double));
+}
+
+void LteTraceChannelModel::verifyRecordedTrace()
+{
+    // read the trace back with the same functions used for replaying it
+    traceMode_ = TRACE_REPLAY;
+    openTrace();
+
+    uint64_t hash = 14695981039346656037ULL;
+    unsigned int numRecords = 0;
+    int64_t lastTime = -1;
+    std::vector<double> values;
+    while (hasNextRecord_) {
+        if (nextRecord_.time < lastTime)
+            throw cRuntimeError("LteTraceChannelModel::verifyRecordedTrace - records of trace '%s' are not sorted by time", traceFileName_.c_str());
+        lastTime = nextRecord_.time;
+
+        values.resize(nextRecord_.size);
+        if (!traceFile_.read(reinterpret_cast<char *>(values.data()), nextRecord_.size * sizeof(double)))
+            throw cRuntimeError("LteTraceChannelModel::verifyRecordedTrace - truncated trace file '%s'", traceFileName_.c_str());
+        hashRecord(hash, nextRecord_, values.data());
+        numRecords++;
+        readNextRecordHeader();
+    }
+    traceFile_.close();
+
+    if (numRecords != numTraceRecords_ || hash != recordHash_)
+        throw cRuntimeError("LteTraceChannelModel::verifyRecordedTrace - trace '%s' contains %u records not matching the %u recorded ones",
+                traceFileName_.c_str(), numRecords, numTraceRecords_);
+    EV << "LteTraceChannelModel::verifyRecordedTrace - trace '" << traceFileName_ << "' verified, " << numRecords << " records" << endl;
+}
+
+void LteTraceChannelModel::verifyReplayedTrace()
+{
+    // the records left in the trace were recorded after the last requested vector
+    countUnreplayedRecords();
+    while (hasNextRecord_) {
+        numUnreplayedRecords_++;
+        traceFile_.seekg(nextRecord_.size * sizeof(double), std::ios::cur);
+        readNextRecordHeader();
+    }
+
+    if (numTraceMisses_ > 0 || numUnreplayedRecords_ > 0)
+        throw cRuntimeError("LteTraceChannelModel::verifyReplayedTrace - the replaying run diverged from the recording one: %u vectors not in trace '%s', %u recorded vectors not replayed",
+                numTraceMisses_, traceFileName_.c_str(), numUnreplayedRecords_);
+    EV << "LteTraceChannelModel::verifyReplayedTrace - trace '" << traceFileName_ << "' verified, " << numTraceHits_ << " vectors replayed" << endl;
+}
+
+void LteTraceChannelModel::openTrace()
+{
+    TraceFileHeader header;
+    if (traceMode_ == TRACE_RECORD) {
+        traceFile_.open(traceFileName_, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!traceFile_.is_open())
+            throw cRuntimeError("LteTraceChannelModel::openTrace - cannot open trace file '%s' for writing", traceFileName_.c_str());
+
+        memcpy(header.magic, traceMagic_, sizeof(header.magic));
+        header.version = traceVersion_;
+        header.timeScaleExp = SimTime::getScaleExp();
+        header.numBands = numBands_;
+        header.reserved = 0;
+        traceFile_.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        return;
+    }
+
+    traceFile_.open(traceFileName_, std::ios::in | std::ios::binary);
+    if (!traceFile_.is_open())
+        throw cRuntimeError("LteTraceChannelModel::openTrace - cannot open trace file '%s'", traceFileName_.c_str());
+
+    if (!traceFile_.read(reinterpret_cast<char *>(&header), sizeof(header)) || memcmp(header.magic, traceMagic_, sizeof(header.magic)) != 0)
+        throw cRuntimeError("LteTraceChannelModel::openTrace - '%s' is not a channel trace", traceFileName_.c_str());
+    if (header.version != traceVersion_)
+        throw cRuntimeError("LteTraceChannelModel::openTrace - unsupported version %u of trace '%s'", header.version, traceFileName_.c_str());
+    if (header.timeScaleExp != SimTime::getScaleExp())
+        throw cRuntimeError("LteTraceChannelModel::openTrace - trace '%s' was recorded with simtime-resolution exponent %d, current one is %d",
+                traceFileName_.c_str(), header.timeScaleExp, SimTime::getScaleExp());
+    if (header.numBands != numBands_)
+        throw cRuntimeError("LteTraceChannelModel::openTrace - trace '%s' was recorded with %u bands, current carrier has %u bands",
+                traceFileName_.c_str(), header.numBands, numBands_);
+
+    readNextRecordHeader();
+}
+
+LteTraceChannelModel::TraceRecordHeader LteTraceChannelModel::makeRecordHeader(MacNodeId ueId, MacNodeId eNbId, Direction dir, TraceRecordKind kind)
+{
+    TraceRecordHeader record;
+    record.time = NOW.raw();
+    record.ueId = num(ueId);
+    record.eNbId = num(eNbId);
+    record.dir = dir;
+    record.kind = kind;
+    record.size = 0;
+    return record;
+}
+
+void LteTraceChannelModel::recordVector(MacNodeId ueId, MacNodeId eNbId, Direction dir, TraceRecordKind kind, const std::vector<double>& values)
+{
+    TraceRecordHeader record = makeRecordHeader(ueId, eNbId, dir, kind);
+    if (record.time != recordTime_) {
+        recordTime_ = record.time;
+        recordedKeys_.clear();
+    }
+    // the first vector computed at a given time is the one that is replayed
+    if (!recordedKeys_.insert(getTraceKey(record)).second)
+        return;
+
+    if (values.size() > UINT16_MAX)
+        throw cRuntimeError("LteTraceChannelModel::recordVector - too many values (%zu)", values.size());
+    record.size = values.size();
+
+    traceFile_.write(reinterpret_cast<const char *>(&record), sizeof(record));
+    traceFile_.write(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(double));
+    if (!traceFile_)
+        throw cRuntimeError("LteTraceChannelModel::recordVector - error while writing trace file '%s'", traceFileName_.c_str());
+    numTraceRecords_++;
+    if (verifyTrace_)
+        hashRecord(recordHash_, record, values.data());
+}
+
+void LteTraceChannelModel::readNextRecordHeader()
+{
+    hasNextRecord_ = static_cast<bool>(traceFile_.read(reinterpret_cast<char *>(&nextRecord_), sizeof(nextRecord_)));
+}
+
+void LteTraceChannelModel::advanceReplay()
+{
+    int64_t now = NOW.raw();
+    if (now == replayTime_)
+        return;
+
+    if (verifyTrace_)
+        countUnreplayedRecords();
+
+    replayTime_ = now;
+    replayIndex_.clear();
+    replayValues_.clear();
+
+    // records are sorted by time: load the ones of the current time instant and skip the older ones,
+    // i.e. those related to time instants where no vector was requested
+    while (hasNextRecord_ && nextRecord_.time <= now) {
+        if (nextRecord_.time < now) {
+            traceFile_.seekg(nextRecord_.size * sizeof(double), std::ios::cur);
+            numUnreplayedRecords_++;
+        }
+        else {
+            size_t offset = replayValues_.size();
+            replayValues_.resize(offset + nextRecord_.size);
+            if (!traceFile_.read(reinterpret_cast<char *>(replayValues_.data() + offset), nextRecord_.size * sizeof(double)))
+                throw cRuntimeError("LteTraceChannelModel::advanceReplay - truncated trace file '%s'", traceFileName_.c_str());
+            replayIndex_.emplace(getTraceKey(nextRecord_), ReplayEntry{offset, nextRecord_.size, false});
+        }
+        readNextRecordHeader();
+    }
+}
+
+void LteTraceChannelModel::countUnreplayedRecords()
+{
+    for (const auto& [key, entry] : replayIndex_) {
+        if (!entry.replayed)
+            numUnreplayedRecords_++;
+    }
+}
+
+bool LteTraceChannelModel::replayVector(MacNodeId ueId, MacNodeId eNbId, Direction dir, TraceRecordKind kind, std::vector<double>& values)
+{
+    advanceReplay();
+
+    auto it = replayIndex_.find(getTraceKey(makeRecordHeader(ueId, eNbId, dir, kind)));
+    if (it == replayIndex_.end()) {
+        numTraceMisses_++;
+        if (!replayFallback_)
+            throw cRuntimeError("LteTraceChannelModel::replayVector - trace '%s' has no vector of kind %d for UE %hu, eNB %hu, direction %s at time %s",
+                    traceFileName_.c_str(), kind, num(ueId), num(eNbId), dirToA(dir).c_str(), NOW.str().c_str());
+        return false;
+    }
+
+    numTraceHits_++;
+    it->second.replayed = true;
+    const double *first = replayValues_.data() + it->second.offset;
+    values.assign(first, first + it->second.size);
+    return true;
+}
+
+void LteTraceChannelModel::getSinrRecordKey(UserControlInfo *lteInfo, MacNodeId& ueId, MacNodeId& eNbId, Direction& dir, TraceRecordKind& kind)
+{
+    dir = (Direction)lteInfo->getDirection();
+    ueId = lteInfo->getSourceId();
+    eNbId = lteInfo->getDestId();
+
+    switch (lteInfo->getFrameType()) {
+        case FEEDBACKPKT:
+            kind = TRACE_SINR_FEEDBACK;
+            return;
+        case HANDOVERPKT:
+            // handover broadcasts must not be mistaken for the data frames sent by the same eNB
+            kind = TRACE_SINR_HANDOVER;
+            break;
+        default:
+            kind = TRACE_SINR_DATA;
+            break;
+    }
+    if (dir == DL)
+        std::swap(ueId, eNbId);
+}
+
+void LteTraceChannelModel::emitReplayedSinr(UserControlInfo *lteInfo, MacNodeId ueId, Direction dir, const std::vector<double>& snrVector)
+{
+    if (!collectSinrStatistics_ || lteInfo->getFrameType() != FEEDBACKPKT || snrVector.empty())
+        return;
+
+    double sumSnr = 0.0;
+    for (double snr : snrVector)
+        sumSnr += snr;
+    emitMeasuredSinr(ueId, dir, lteInfo->getCarrierFrequency(), sumSnr / snrVector.size());
+}
+
+void LteTraceChannelModel::getSINR(LteAirFrame *frame, UserControlInfo *lteInfo, std::vector<double>& snrVector)
+{
+    MacNodeId ueId, eNbId;
+    Direction dir;
+    TraceRecordKind kind;
+    getSinrRecordKey(lteInfo, ueId, eNbId, dir, kind);
+
+    if (traceMode_ == TRACE_REPLAY) {
+        if (replayVector(ueId, eNbId, dir, kind, snrVector)) {
+            emitReplayedSinr(lteInfo, ueId, dir, snrVector);
+            return;
+        }
+        LteRealisticChannelModel::getSINR(frame, lteInfo, snrVector);
+        return;
+    }
+
+    LteRealisticChannelModel::getSINR(frame, lteInfo, snrVector);
+    recordVector(ueId, eNbId, dir, kind, snrVector);
+}
+
+void LteTraceChannelModel::getFeedbackSINR(LteAirFrame *frame, UserControlInfo *lteInfo, std::vector<double>& snrVector)
+{
+    MacNodeId ueId, eNbId;
+    Direction dir;
+    TraceRecordKind kind;
+    getSinrRecordKey(lteInfo, ueId, eNbId, dir, kind);
+
+    if (traceMode_ == TRACE_REPLAY) {
+        if (replayVector(ueId, eNbId, dir, kind, snrVector)) {
+            emitReplayedSinr(lteInfo, ueId, dir, snrVector);
+            return;
+        }
+        LteRealisticChannelModel::getFeedbackSINR(frame, lteInfo, snrVector);
+        return;
+    }
+
+    // when the vector is computed rather than taken from the feedback sinr cache, getSINR() has
+    // already recorded it, and recordVector() skips the duplicate
+    LteRealisticChannelModel::getFeedbackSINR(frame, lteInfo, snrVector);
+    recordVector(ueId, eNbId, dir, kind, snrVector);
+}
+
+void LteTraceChannelModel::computeRSRP(MacNodeId ueId, MacNodeId eNbId, Direction dir, bool feedback, double txPower, const inet::Coord& coord, std::vector<double>& rsrpVector)
+{
+    TraceRecordKind kind = feedback ? TRACE_RSRP_FEEDBACK : TRACE_RSRP;
+
+    if (traceMode_ == TRACE_REPLAY) {
+        if (!replayVector(ueId, eNbId, dir, kind, rsrpVector))
+            LteRealisticChannelModel::computeRSRP(ueId, eNbId, dir, feedback, txPower, coord, rsrpVector);
+        return;
+    }
+
+    LteRealisticChannelModel::computeRSRP(ueId, eNbId, dir, feedback, txPower, coord, rsrpVector);
+    recordVector(ueId, eNbId, dir, kind, rsrpVector);
+}
+
+} //namespace
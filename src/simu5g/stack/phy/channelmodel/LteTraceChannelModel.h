@@ -0,0 +1,189 @@
+//
+//                  Simu5G
+//
+// Copyright (C) 2022-2026 Giovanni Nardini, Giovanni Stea et al. (University of Pisa)
+//
+// This file is part of a software released under the license included in file
+// "license.pdf". Please read LICENSE and README files before using it.
+// The above files and the present reference are part of the software itself,
+// and cannot be removed from it.
+//
+
+#ifndef STACK_PHY_CHANNELMODEL_LTETRACECHANNELMODEL_H_
+#define STACK_PHY_CHANNELMODEL_LTETRACECHANNELMODEL_H_
+
+#include <fstream>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "simu5g/stack/phy/channelmodel/LteRealisticChannelModel.h"
+
+namespace simu5g {
+
+/*
+ * Channel model that records the SINR and RSRP vectors computed by LteRealisticChannelModel
+ * to a binary trace file (record mode), or streams them back from a previously recorded trace
+ * instead of computing path loss, shadowing, fading and interference (replay mode).
+ *
+ * The trace file is made of a header followed by one record per UE, eNB, direction and kind
+ * of vector (data SINR, feedback SINR, handover SINR, RSRP, feedback RSRP) for each time instant, sorted by
+ * time. Each record is a TraceRecordHeader followed by one double per band, in native byte order.
+ */
+class LteTraceChannelModel : public LteRealisticChannelModel
+{
+  public:
+    enum TraceMode
+    {
+        TRACE_RECORD, TRACE_REPLAY
+    };
+
+    enum TraceRecordKind : uint8_t
+    {
+        TRACE_SINR_DATA, TRACE_SINR_FEEDBACK, TRACE_RSRP, TRACE_RSRP_FEEDBACK, TRACE_SINR_HANDOVER
+    };
+
+  protected:
+    struct TraceFileHeader
+    {
+        char magic[8];
+        uint32_t version;
+        int32_t timeScaleExp;
+        uint32_t numBands;
+        uint32_t reserved;
+    };
+
+    struct TraceRecordHeader
+    {
+        int64_t time;      // raw simulation time
+        uint16_t ueId;
+        uint16_t eNbId;
+        uint8_t dir;
+        uint8_t kind;
+        uint16_t size;     // number of values following the header
+    };
+
+    struct ReplayEntry
+    {
+        size_t offset;     // position of the values in replayValues_
+        unsigned int size;
+        bool replayed;
+    };
+
+    static const char traceMagic_[8];
+    static const uint32_t traceVersion_ = 2;
+
+    TraceMode traceMode_ = TRACE_RECORD;
+    std::string traceFileName_;
+    std::fstream traceFile_;
+
+    // if true, vectors not found in the trace are computed, otherwise an error is raised
+    bool replayFallback_ = true;
+
+    // record mode: if true, the trace is read back at the end of the simulation and checked
+    // against the hash of the recorded records.
+    // replay mode: if true, an error is raised if any recorded vector was not replayed, or
+    // any requested vector was not in the trace
+    bool verifyTrace_ = false;
+    uint64_t recordHash_ = 14695981039346656037ULL;
+
+    // record mode: keys of the records written for the current time instant
+    int64_t recordTime_ = -1;
+    std::unordered_set<uint64_t> recordedKeys_;
+
+    // replay mode: records of the current time instant, and the header of the next record in the file
+    int64_t replayTime_ = -1;
+    std::unordered_map<uint64_t, ReplayEntry> replayIndex_;
+    std::vector<double> replayValues_;
+    TraceRecordHeader nextRecord_;
+    bool hasNextRecord_ = false;
+
+    // statistics
+    unsigned int numTraceHits_ = 0;
+    unsigned int numTraceMisses_ = 0;
+    unsigned int numTraceRecords_ = 0;
+    unsigned int numUnreplayedRecords_ = 0;
+
+  public:
+    void initialize(int stage) override;
+    void finish() override;
+
+    using LteRealisticChannelModel::getSINR;
+
+    /*
+     * Returns the SINR vector stored in the trace or, in record mode, computes it
+     * through LteRealisticChannelModel and stores it in the trace
+     */
+    void getSINR(LteAirFrame *frame, UserControlInfo *lteInfo, std::vector<double>& snrVector) override;
+
+    /*
+     * Same as getSINR(). In record mode, the SINR reused by the feedback SINR cache is recorded too,
+     * so that the trace contains every feedback computed in the recording run
+     */
+    void getFeedbackSINR(LteAirFrame *frame, UserControlInfo *lteInfo, std::vector<double>& snrVector) override;
+
+  protected:
+    void computeRSRP(MacNodeId ueId, MacNodeId eNbId, Direction dir, bool feedback, double txPower, const inet::Coord& coord, std::vector<double>& rsrpVector) override;
+
+    /*
+     * Returns the identifier of the SINR vector computed for the given frame, with the
+     * same UE and eNB roles as in LteRealisticChannelModel::getSINR()
+     */
+    static void getSinrRecordKey(UserControlInfo *lteInfo, MacNodeId& ueId, MacNodeId& eNbId, Direction& dir, TraceRecordKind& kind);
+
+    /*
+     * Emits the SINR statistics for a feedback SINR vector read from the trace
+     */
+    void emitReplayedSinr(UserControlInfo *lteInfo, MacNodeId ueId, Direction dir, const std::vector<double>& snrVector);
+
+    static TraceRecordHeader makeRecordHeader(MacNodeId ueId, MacNodeId eNbId, Direction dir, TraceRecordKind kind);
+
+    static uint64_t getTraceKey(const TraceRecordHeader& record)
+    {
+        return record.ueId | ((uint64_t)record.eNbId << 16) | ((uint64_t)record.dir << 32) | ((uint64_t)record.kind << 40);
+    }
+
+    void openTrace();
+
+    /*
+     * Appends the given vector to the trace, unless a vector with the same key
+     * has already been recorded for the current time instant
+     */
+    void recordVector(MacNodeId ueId, MacNodeId eNbId, Direction dir, TraceRecordKind kind, const std::vector<double>& values);
+
+    /*
+     * Copies the vector with the given key for the current time instant into values
+     * @return false if the trace does not contain such vector
+     */
+    bool replayVector(MacNodeId ueId, MacNodeId eNbId, Direction dir, TraceRecordKind kind, std::vector<double>& values);
+
+    /*
+     * Loads the records of the current time instant, skipping older ones
+     */
+    void advanceReplay();
+
+    /*
+     * Counts the records of the current time instant that have not been replayed
+     */
+    void countUnreplayedRecords();
+    void readNextRecordHeader();
+
+    /*
+     * Accumulates a record into the given hash (FNV-1a over the header and the values)
+     */
+    static void hashRecord(uint64_t& hash, const TraceRecordHeader& record, const double *values);
+
+    /*
+     * Reopens the recorded trace in replay mode and checks that it contains the recorded records,
+     * sorted by time
+     */
+    void verifyRecordedTrace();
+
+    /*
+     * Checks that the replaying run requested exactly the vectors of the recording run
+     */
+    void verifyReplayedTrace();
+};
+
+} //namespace
+
+#endif /* STACK_PHY_CHANNELMODEL_LTETRACECHANNELMODEL_H_ */
@@ -42,21 +42,24 @@ double NrChannelModel::getAttenuation(MacNodeId nodeId, Direction dir, inet::Coo
     // If the traveled distance is greater than the correlation distance, the UE could have changed its state and
     // its visibility from the eNodeB, hence it is correct to recompute the LOS probability.
     if (movement > correlationDistance_
-        || losMap_.find(nodeId) == losMap_.end())
+        || !hasLosState(nodeId))
     {
         computeLosProbability(twoDimDistance, nodeId);
     }
 
     // compute attenuation based on selected scenario and based on LOS or NLOS
-    bool los = losMap_[nodeId];
-    double attenuation = computePathLoss(threeDimDistance, twoDimDistance, los);
-
-    // Applying shadowing only if it is enabled by configuration
-    // log-normal shadowing (not available for background UEs)
-    if (num(nodeId) < BGUE_MIN_ID && shadowing_)
-        attenuation += computeShadowing(twoDimDistance, nodeId, speed, cqiDl);
+    bool los = losState(nodeId);
+    double attenuation;
+    double *linkPathLoss = getLinkBudgetPathLoss(nodeId, coord, los);
+    if (linkPathLoss != nullptr && !std::isnan(*linkPathLoss))
+        attenuation = *linkPathLoss;
+    else {
+        attenuation = computePathLoss(threeDimDistance, twoDimDistance, los);
+        if (linkPathLoss != nullptr)
+            *linkPathLoss = attenuation;
+    }
 
-    // update current user position
+    // update current user position (before the shadowing, which may depend on it)
 
     // if sender is an eNodeB
     if (dir == DL)
@@ -66,6 +69,11 @@ double NrChannelModel::getAttenuation(MacNodeId nodeId, Direction dir, inet::Coo
         // sender is a UE
         updatePositionHistory(nodeId, coord);
 
+    // Applying shadowing only if it is enabled by configuration
+    // log-normal shadowing (not available for background UEs)
+    if (num(nodeId) < BGUE_MIN_ID && shadowing_)
+        attenuation += computeShadowing(twoDimDistance, nodeId, speed, cqiDl);
+
     EV << "NrChannelModel::getAttenuation - computed attenuation at distance " << threeDimDistance << " for eNb is " << attenuation << endl;
 
     return attenuation;
@@ -95,7 +103,7 @@ void NrChannelModel::computeLosProbability(double d, MacNodeId nodeId)
 {
     double p = 0;
     if (!dynamicLos_) {
-        losMap_[nodeId] = fixedLos_;
+        losState(nodeId) = fixedLos_;
         return;
     }
     switch (scenario_) {
@@ -125,9 +133,9 @@ void NrChannelModel::computeLosProbability(double d, MacNodeId nodeId)
     }
     double random = uniform(0.0, 1.0);
     if (random <= p)
-        losMap_[nodeId] = true;
+        losState(nodeId) = true;
     else
-        losMap_[nodeId] = false;
+        losState(nodeId) = false;
 }
 
 double NrChannelModel::computePathLoss(double threeDimDistance, double twoDimDistance, bool los)
@@ -328,86 +336,36 @@ double NrChannelModel::computeRuralMacro(double threeDimDistance, double twoDimD
     return pLoss_nlos;
 }
 
-bool NrChannelModel::computeExtCellInterference(MacNodeId eNbId, MacNodeId nodeId, Coord coord, bool isCqi, GHz carrierFrequency,
-        std::vector<double> *interference)
+double NrChannelModel::computeExtCellReceivedPower(ExtCell *extCell, MacNodeId nodeId, const Coord& coord)
 {
-    EV << "**** Ext Cell Interference **** " << endl;
-
-    // get external cell list
-    ExtCellList list = binder_->getExtCellList(carrierFrequency);
-
-    Coord c;
-    double threeDimDist, // meters
-           twoDimDist, // meters
-           recvPwr, // watt
-           recvPwrDBm, // dBm
-           att, // dBm
-           angularAtt; // dBm
-
-    std::vector<double> fadingAttenuation;
-
-    // compute distance for each cell
-    for (const auto& extCell : list) {
-        // get external cell position
-        c = extCell->getPosition();
-        // compute distance between UE and the ext cell
-        threeDimDist = coord.distance(c);
-        twoDimDist = getTwoDimDistance(coord, c);
-
-        EV << "\t distance between UE[" << coord.x << "," << coord.y <<
-            "] and extCell[" << c.x << "," << c.y << "] is -> "
-           << threeDimDist << "\t";
-
-        // compute attenuation according to some path loss model
-        att = computeExtCellPathLoss(threeDimDist, twoDimDist, nodeId);
-
-        //=============== ANGULAR ATTENUATION =================
-        if (extCell->getTxDirection() == OMNI) {
-            angularAtt = 0;
-        }
-        else {
-            // compute the angle between uePosition and reference axis, considering the eNb as center
-            double ueAngle = computeAngle(c, coord);
-
-            // compute the reception angle between ue and eNb
-            double recvAngle = fabs(extCell->getTxAngle() - ueAngle);
-
-            if (recvAngle > 180)
-                recvAngle = 360 - recvAngle;
-
-            double verticalAngle = computeVerticalAngle(c, coord);
-
-            // compute attenuation due to sectorial tx
-            angularAtt = computeAngularAttenuation(recvAngle, verticalAngle);
-        }
-        //=============== END ANGULAR ATTENUATION =================
-
-        // TODO do we need to use (- cableLoss_ + antennaGainEnB_) in ext cells too?
-        // compute and linearize received power
-        recvPwrDBm = extCell->getTxPower() - att - angularAtt - cableLoss_ + antennaGainEnB_ + antennaGainUe_;
-        recvPwr = dBmToLinear(recvPwrDBm);
-
-        int numBands = std::min(numBands_, extCell->getNumBands());
-        EV << " - shared bands [" << numBands << "]" << endl;
-
-        // add interference in those bands where the ext cell is active
-        for (unsigned int i = 0; i < numBands; i++) {
-            int occ;
-            if (isCqi) { // check slot occupation for this TTI
-                occ = extCell->getBandStatus(i);
-            }
-            else {      // error computation. We need to check the slot occupation of the previous TTI
-                occ = extCell->getPrevBandStatus(i);
-            }
-
-            // if the ext cell is active, add interference
-            if (occ) {
-                (*interference)[i] += recvPwr;
-            }
-        }
+    // get external cell position
+    Coord c = extCell->getPosition();
+    // compute distance between UE and the ext cell
+    double threeDimDist = coord.distance(c);
+    double twoDimDist = getTwoDimDistance(coord, c);
+
+    EV << "\t distance between UE[" << coord.x << "," << coord.y <<
+        "] and extCell[" << c.x << "," << c.y << "] is -> "
+       << threeDimDist << "\t";
+
+    // compute attenuation according to some path loss model
+    double att = computeExtCellPathLoss(threeDimDist, twoDimDist, nodeId);
+
+    //=============== ANGULAR ATTENUATION =================
+    double angularAtt;
+    if (extCell->getTxDirection() == OMNI) {
+        angularAtt = 0;
     }
+    else {
+        // compute attenuation due to sectorial tx
+        angularAtt = getAngularAttenuation(c, coord, extCell->getTxAngle());
+    }
+    //=============== END ANGULAR ATTENUATION =================
+
+    EV << " - shared bands [" << std::min(numBands_, extCell->getNumBands()) << "]" << endl;
 
-    return true;
+    // TODO do we need to use (- cableLoss_ + antennaGainEnB_) in ext cells too?
+    return extCell->getTxPower() - att - angularAtt - cableLoss_ + antennaGainEnB_ + antennaGainUe_;
 }
 
 double NrChannelModel::computeExtCellPathLoss(double threeDimDistance, double twoDimDistance, MacNodeId nodeId)
@@ -415,7 +373,7 @@ double NrChannelModel::computeExtCellPathLoss(double threeDimDistance, double tw
     computeSpeed(nodeId, phy_->getCoord());
 
     // Compute attenuation based on selected scenario and based on LOS or NLOS
-    bool los = losMap_[nodeId];
+    bool los = losState(nodeId);
 
     if (!enable_extCell_los_)
         los = false;
@@ -428,7 +386,10 @@ double NrChannelModel::computeExtCellPathLoss(double threeDimDistance, double tw
     if (shadowing_) {
         double att;
 
-        att = lastComputedSF_.at(nodeId).second;
+        NodeChannelState *state = findNodeState(nodeId);
+        if (state == nullptr || !state->hasShadowing)
+            throw cRuntimeError("NrChannelModel::computeExtCellPathLoss - shadowing not computed for node %hu", num(nodeId));
+        att = state->shadowing;
         EV << "(" << att << ")";
         attenuation += att;
     }
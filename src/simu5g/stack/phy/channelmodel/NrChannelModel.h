@@ -89,10 +89,10 @@ class NrChannelModel : public LteRealisticChannelModel
     double computeRuralMacro(double threeDimDistance, double twoDimDistance, bool los);
 
     /*
-     * Evaluates total interference from external cells seen from the spot given by coord
-     * @return total interference expressed in dBm
+     * Computes the power received at the spot given by coord from the given external cell
+     * @return received power expressed in dBm
      */
-    bool computeExtCellInterference(MacNodeId eNbId, MacNodeId nodeId, inet::Coord coord, bool isCqi, GHz carrierFrequency, std::vector<double> *interference) override;
+    double computeExtCellReceivedPower(ExtCell *extCell, MacNodeId nodeId, const inet::Coord& coord) override;
 
     /*
      * Compute attenuation due to path loss and shadowing
@@ -21,13 +21,21 @@ void NrChannelModel_3GPP38_901::initialize(int stage)
     NrChannelModel::initialize(stage);
     if (inside_building_)
         useBuildingPenetrationHighLossModel_ = par("useBuildingPenetrationHighLossModel").boolValue();
+
+    if (stage == inet::INITSTAGE_LOCAL) {
+        shadowingGrid_ = par("shadowingGrid");
+        shadowingGridResolution_ = par("shadowingGridResolution");
+        shadowingGridExtent_ = par("shadowingGridExtent");
+        if (shadowingGrid_ && (shadowingGridResolution_ <= 0.0 || shadowingGridExtent_ <= 0.0))
+            throw cRuntimeError("NrChannelModel_3GPP38_901::initialize - shadowingGridResolution and shadowingGridExtent must be positive");
+    }
 }
 
 void NrChannelModel_3GPP38_901::computeLosProbability(double d, MacNodeId nodeId)
 {
     double p = 0;
     if (!dynamicLos_) {
-        losMap_[nodeId] = fixedLos_;
+        losState(nodeId) = fixedLos_;
         return;
     }
 
@@ -67,9 +75,9 @@ void NrChannelModel_3GPP38_901::computeLosProbability(double d, MacNodeId nodeId
 
     double random = uniform(0.0, 1.0);
     if (random <= p)
-        losMap_[nodeId] = true;
+        losState(nodeId) = true;
     else
-        losMap_[nodeId] = false;
+        losState(nodeId) = false;
 }
 
 double NrChannelModel_3GPP38_901::computePenetrationLoss(double threeDimDistance)
@@ -299,22 +307,22 @@ double NrChannelModel_3GPP38_901::getStdDev(bool dist, MacNodeId nodeId)
 {
     switch (scenario_) {
         case URBAN_MICROCELL:
-            if (losMap_[nodeId])
+            if (losState(nodeId))
                 return 4.;
             else
                 return 7.82;
         case INDOOR_HOTSPOT:
-            if (losMap_[nodeId])
+            if (losState(nodeId))
                 return 3.;
             else
                 return 8.03;
         case URBAN_MACROCELL:
-            if (losMap_[nodeId])
+            if (losState(nodeId))
                 return 4.;
             else
                 return 6.;
         case RURAL_MACROCELL:
-            if (losMap_[nodeId]) {
+            if (losState(nodeId)) {
                 if (dist)
                     return 4.;
                 else
@@ -330,16 +338,6 @@ double NrChannelModel_3GPP38_901::getStdDev(bool dist, MacNodeId nodeId)
 
 double NrChannelModel_3GPP38_901::computeShadowing(double sqrDistance, MacNodeId nodeId, double speed, bool cqiDl)
 {
-    ShadowFadingMap *actualShadowingMap;
-
-    if (cqiDl) // If we are computing a DL CQI we need the Shadowing Map stored on the UE side
-        actualShadowingMap = obtainShadowingMap(nodeId);
-    else
-        actualShadowingMap = &lastComputedSF_;
-
-    if (actualShadowingMap == nullptr)
-        throw cRuntimeError("NrChannelModel_3GPP38_901::computeShadowing - actualShadowingMap not found (nullptr)");
-
     double mean = 0;
     double dbp = 0.0;
     // Get std deviation according to los/nlos and selected scenario
@@ -349,28 +347,60 @@ double NrChannelModel_3GPP38_901::computeShadowing(double sqrDistance, MacNodeId
     double space = 0;
     double att;
 
+    if (shadowingGrid_) {
+        // The shadowing depends on the position of the UE only, hence it is the same for
+        // the UL and DL directions and no state has to be retrieved from the UE side
+        bool los = losState(nodeId);
+        const PositionHistory& positionHistory = obtainNodeState(nodeId).positionHistory;
+        if (positionHistory.size == 0)
+            throw cRuntimeError("NrChannelModel_3GPP38_901::computeShadowing - position of node %hu unknown", num(nodeId));
+        inet::Coord position = positionHistory.back().second;
+
+        att = stdDev * getShadowingGridOwner(nodeId)->obtainShadowingGrid(los).sample(position);
+
+        // Store the shadowing attenuation, which is used for the interference of the external cells
+        NodeChannelState& state = obtainNodeState(nodeId);
+        state.hasShadowing = true;
+        state.shadowingTime = NOW;
+        state.shadowing = att;
+
+        EV << " NrChannelModel_3GPP38_901::computeShadowing - shadowing att = " << att << " (grid)" << endl;
+        return att;
+    }
+
+    NodeChannelState *actualShadowingState;
+
+    if (cqiDl) // If we are computing a DL CQI we need the shadowing stored on the UE side
+        actualShadowingState = obtainUeNodeState(nodeId);
+    else
+        actualShadowingState = &obtainNodeState(nodeId);
+
+    if (actualShadowingState == nullptr)
+        throw cRuntimeError("NrChannelModel_3GPP38_901::computeShadowing - actualShadowingState not found (nullptr)");
+
     // If direction is DOWNLINK it means that this module is located in UE stack than
     // the Move object associated with the UE is myMove_ variable
     // If direction is UPLINK it means that this module is located in UE stack than
     // the Move object associated with the UE is move variable
 
     // If shadowing for current user has never been computed
-    if (actualShadowingMap->find(nodeId) == actualShadowingMap->end()) {
+    if (!actualShadowingState->hasShadowing) {
         // Get the log normal shadowing with std deviation stdDev
         att = normal(mean, stdDev);
 
         // Store the shadowing attenuation for this user and the temporal mark
-        std::pair<simtime_t, double> tmp(NOW, att);
-        (*actualShadowingMap)[nodeId] = tmp;
+        actualShadowingState->hasShadowing = true;
+        actualShadowingState->shadowingTime = NOW;
+        actualShadowingState->shadowing = att;
 
         // If the shadowing attenuation has been computed at least one time for this user
         // and the distance traveled by the UE is greater than correlation distance
     }
-    else if ((NOW - actualShadowingMap->at(nodeId).first).dbl() * speed
+    else if ((NOW - actualShadowingState->shadowingTime).dbl() * speed
              > correlationDistance_)
     {
         // Get the temporal mark of the last computed shadowing attenuation
-        time = (NOW - actualShadowingMap->at(nodeId).first).dbl();
+        time = (NOW - actualShadowingState->shadowingTime).dbl();
 
         // Compute the traveled distance
         space = time * speed;
@@ -379,24 +409,105 @@ double NrChannelModel_3GPP38_901::computeShadowing(double sqrDistance, MacNodeId
         double a = exp(-0.5 * (space / correlationDistance_));
 
         // Get last shadowing attenuation computed
-        double old = actualShadowingMap->at(nodeId).second;
+        double old = actualShadowingState->shadowing;
 
         // Compute shadowing with an EAW (Exponential Average Window) (step2)
         att = a * old + sqrt(1 - pow(a, 2)) * normal(mean, stdDev);
 
         // Store the new computed shadowing
-        std::pair<simtime_t, double> tmp(NOW, att);
-        (*actualShadowingMap)[nodeId] = tmp;
+        actualShadowingState->shadowingTime = NOW;
+        actualShadowingState->shadowing = att;
 
         // If the distance traveled by the UE is smaller than correlation distance shadowing attenuation remains the same
     }
     else {
-        att = actualShadowingMap->at(nodeId).second;
+        att = actualShadowingState->shadowing;
     }
     EV << " NrChannelModel_3GPP38_901::computeShadowing - shadowing att = " << att << endl;
 
     return att;
 }
 
+double NrChannelModel_3GPP38_901::ShadowingGrid::sample(const inet::Coord& position) const
+{
+    // positions outside the grid are mapped onto its border
+    double maxIndex = size - 1;
+    double x = std::min(std::max((position.x - origin.x) / resolution, 0.0), maxIndex);
+    double y = std::min(std::max((position.y - origin.y) / resolution, 0.0), maxIndex);
+    unsigned int x0 = std::min((unsigned int)x, size - 2);
+    unsigned int y0 = std::min((unsigned int)y, size - 2);
+    double fx = x - x0;
+    double fy = y - y0;
+
+    // bilinear interpolation of the four surrounding points
+    const double *row0 = &values[y0 * size + x0];
+    const double *row1 = row0 + size;
+    return (1 - fy) * ((1 - fx) * row0[0] + fx * row0[1]) + fy * ((1 - fx) * row1[0] + fx * row1[1]);
+}
+
+const NrChannelModel_3GPP38_901::ShadowingGrid& NrChannelModel_3GPP38_901::obtainShadowingGrid(bool los)
+{
+    ShadowingGrid& grid = shadowingGrids_[los ? 1 : 0];
+    if (grid.size > 0)
+        return grid;
+
+    // the grid covers the square of side 2*shadowingGridExtent_ centered on this node
+    inet::Coord center = phy_->getCoord();
+    unsigned int halfSize = ceil(shadowingGridExtent_ / shadowingGridResolution_);
+    grid.resolution = shadowingGridResolution_;
+    grid.size = 2 * halfSize + 1;
+    grid.origin = inet::Coord(center.x - halfSize * grid.resolution, center.y - halfSize * grid.resolution, 0.0);
+
+    // independent Gaussian values, filtered with a first-order autoregressive filter along
+    // both axes: this yields unit-variance values whose correlation decays as
+    // exp(-d/correlationDistance) along each axis
+    std::vector<double>& values = grid.values;
+    values.resize(grid.size * grid.size);
+    for (double& value : values)
+        value = normal(0.0, 1.0);
+
+    double a = exp(-grid.resolution / getShadowingCorrelationDistance(los));
+    double b = sqrt(1 - a * a);
+    for (unsigned int y = 0; y < grid.size; y++)
+        for (unsigned int x = 1; x < grid.size; x++)
+            values[y * grid.size + x] = a * values[y * grid.size + x - 1] + b * values[y * grid.size + x];
+    for (unsigned int y = 1; y < grid.size; y++)
+        for (unsigned int x = 0; x < grid.size; x++)
+            values[y * grid.size + x] = a * values[(y - 1) * grid.size + x] + b * values[y * grid.size + x];
+
+    EV << "NrChannelModel_3GPP38_901::obtainShadowingGrid - generated " << (los ? "LOS" : "NLOS") << " shadowing grid of "
+       << grid.size << "x" << grid.size << " points" << endl;
+
+    return grid;
+}
+
+NrChannelModel_3GPP38_901 *NrChannelModel_3GPP38_901::getShadowingGridOwner(MacNodeId nodeId)
+{
+    MacNodeId servingNodeId = binder_->getNextHop(nodeId);
+    if (servingNodeId == phy_->getMacNodeId())
+        return this;
+
+    // the grids of the serving gNodeB are shared by the links of all the UEs in the cell
+    LtePhyBase *servingPhy = (servingNodeId != NODEID_NONE) ? dynamic_cast<LtePhyBase *>(binder_->getPhyByNodeId(servingNodeId)) : nullptr;
+    NrChannelModel_3GPP38_901 *owner = (servingPhy != nullptr) ? dynamic_cast<NrChannelModel_3GPP38_901 *>(servingPhy->getChannelModel(carrierFrequency_)) : nullptr;
+    return (owner != nullptr) ? owner : this;
+}
+
+double NrChannelModel_3GPP38_901::getShadowingCorrelationDistance(bool los)
+{
+    switch (scenario_) {
+        case URBAN_MICROCELL:
+            return los ? 10.0 : 13.0;
+        case URBAN_MACROCELL:
+            return los ? 37.0 : 50.0;
+        case RURAL_MACROCELL:
+            return los ? 37.0 : 120.0;
+        case INDOOR_HOTSPOT:
+            return los ? 10.0 : 6.0;
+        default:
+            return correlationDistance_;
+    }
+}
+
 } //namespace
 
@@ -38,6 +38,45 @@ namespace simu5g {
  */
 class NrChannelModel_3GPP38_901 : public NrChannelModel
 {
+  protected:
+    /*
+     * Map of spatially-correlated, unit-variance Gaussian values, pre-generated on a square grid
+     * and sampled by bilinear interpolation (see the spatial consistency procedure, Section 7.6.3 of TR 38.901)
+     */
+    struct ShadowingGrid
+    {
+        inet::Coord origin;         // position of the first point of the grid
+        double resolution = 0.0;    // distance between adjacent points
+        unsigned int size = 0;      // number of points per side
+        std::vector<double> values; // values[y * size + x]
+
+        double sample(const inet::Coord& position) const;
+    };
+
+    // if true, the shadowing is sampled from the shadowing grids of the serving gNodeB
+    bool shadowingGrid_ = false;
+    double shadowingGridResolution_ = 0.0;
+    double shadowingGridExtent_ = 0.0;
+
+    // shadowing grids for NLOS (index 0) and LOS (index 1) links, centered on the
+    // position of this node and generated on first use
+    ShadowingGrid shadowingGrids_[2];
+
+    /*
+     * Returns the shadowing grid of this node for LOS or NLOS links
+     */
+    const ShadowingGrid& obtainShadowingGrid(bool los);
+
+    /*
+     * Returns the channel model owning the shadowing grids used for the given UE, i.e.,
+     * the one of its serving gNodeB on this carrier (this one if not available)
+     */
+    NrChannelModel_3GPP38_901 *getShadowingGridOwner(MacNodeId nodeId);
+
+    /*
+     * Returns the decorrelation distance of the shadowing (Table 7.5-6 of TR 38.901)
+     */
+    double getShadowingCorrelationDistance(bool los);
 
   public:
     void initialize(int stage) override;
@@ -34,7 +34,7 @@ class LteFeedbackComputation
     virtual LteFeedbackDoubleVector computeFeedback(FeedbackType fbType, RbAllocationType rbAllocationType,
             TxMode currentTxMode,
             std::map<Remote, int> antennaCws, int numPreferredBands,
-            int numRus, std::vector<double> snr, MacNodeId id = NODEID_NONE) = 0;
+            int numRus, const std::vector<double>& snr, MacNodeId id = NODEID_NONE) = 0;
     /**
      * Interface for Feedback computation
      *
@@ -49,7 +49,7 @@ class LteFeedbackComputation
     virtual LteFeedbackVector computeFeedback(const Remote remote, FeedbackType fbType,
             RbAllocationType rbAllocationType, TxMode currentTxMode,
             int antennaCws, int numPreferredBands, int numRus,
-            std::vector<double> snr, MacNodeId id = NODEID_NONE) = 0;
+            const std::vector<double>& snr, MacNodeId id = NODEID_NONE) = 0;
     /**
      * Interface for Feedback computation
      *
@@ -65,7 +65,7 @@ class LteFeedbackComputation
     virtual LteFeedback computeFeedback(const Remote remote, TxMode txmode, FeedbackType fbType,
             RbAllocationType rbAllocationType,
             int antennaCws, int numPreferredBands, int numRus,
-            std::vector<double> snr, MacNodeId id = NODEID_NONE) = 0;
+            const std::vector<double>& snr, MacNodeId id = NODEID_NONE) = 0;
 };
 
 } //namespace
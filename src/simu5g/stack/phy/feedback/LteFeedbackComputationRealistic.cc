@@ -28,7 +28,7 @@ LteFeedbackComputationRealistic::LteFeedbackComputationRealistic(Binder *binder,
 
 
 void LteFeedbackComputationRealistic::generateBaseFeedback(int numBands, int numPreferredBands, LteFeedback& fb,
-        FeedbackType fbType, int cw, RbAllocationType rbAllocationType, TxMode txmode, std::vector<double> snr)
+        FeedbackType fbType, int cw, RbAllocationType rbAllocationType, TxMode txmode, const std::vector<double>& snr)
 {
     int layer = 1;
     std::vector<CqiVector> cqiTmp2;
@@ -108,7 +108,7 @@ Cqi LteFeedbackComputationRealistic::getCqi(TxMode txmode, double snr)
 LteFeedbackDoubleVector LteFeedbackComputationRealistic::computeFeedback(FeedbackType fbType,
         RbAllocationType rbAllocationType, TxMode currentTxMode,
         std::map<Remote, int> antennaCws, int numPreferredBands, int numRus,
-        std::vector<double> snr, MacNodeId id)
+        const std::vector<double>& snr, MacNodeId id)
 {
     // Add enodeB to the number of antennas
     numRus++;
@@ -140,7 +140,7 @@ LteFeedbackDoubleVector LteFeedbackComputationRealistic::computeFeedback(Feedbac
 LteFeedbackVector LteFeedbackComputationRealistic::computeFeedback(const Remote remote, FeedbackType fbType,
         RbAllocationType rbAllocationType, TxMode currentTxMode,
         int antennaCws, int numPreferredBands, int numRus,
-        std::vector<double> snr, MacNodeId id)
+        const std::vector<double>& snr, MacNodeId id)
 {
     LteFeedbackVector fbv;
     fbv.resize(DL_NUM_TXMODE);
@@ -164,7 +164,7 @@ LteFeedbackVector LteFeedbackComputationRealistic::computeFeedback(const Remote
 LteFeedback LteFeedbackComputationRealistic::computeFeedback(const Remote remote, TxMode txmode, FeedbackType fbType,
         RbAllocationType rbAllocationType,
         int antennaCws, int numPreferredBands, int numRus,
-        std::vector<double> snr, MacNodeId id)
+        const std::vector<double>& snr, MacNodeId id)
 {
     // New Feedback
     LteFeedback fb;
@@ -178,7 +178,7 @@ LteFeedback LteFeedbackComputationRealistic::computeFeedback(const Remote remote
     return fb;
 }
 
-double LteFeedbackComputationRealistic::meanSnr(std::vector<double> snr)
+double LteFeedbackComputationRealistic::meanSnr(const std::vector<double>& snr)
 {
     double mean = 0;
     for (const auto& value : snr)
@@ -34,10 +34,10 @@ class LteFeedbackComputationRealistic : public LteFeedbackComputation
     unsigned int computeRank(MacNodeId id);
     // Generate base feedback for all types of feedback (all bands, preferred, wideband)
     void generateBaseFeedback(int numBands, int numPreferredBands, LteFeedback& fb, FeedbackType fbType, int cw,
-            RbAllocationType rbAllocationType, TxMode txmode, std::vector<double> snr);
+            RbAllocationType rbAllocationType, TxMode txmode, const std::vector<double>& snr);
     // Get CQI from BLER Curves
     Cqi getCqi(TxMode txmode, double snr);
-    double meanSnr(std::vector<double> snr);
+    double meanSnr(const std::vector<double>& snr);
 
   public:
     LteFeedbackComputationRealistic(Binder *binder, double targetBler, unsigned int numBands);
@@ -45,17 +45,17 @@ class LteFeedbackComputationRealistic : public LteFeedbackComputation
     LteFeedbackDoubleVector computeFeedback(FeedbackType fbType, RbAllocationType rbAllocationType,
             TxMode currentTxMode,
             std::map<Remote, int> antennaCws, int numPreferredBands,
-            int numRus, std::vector<double> snr, MacNodeId id = NODEID_NONE) override;
+            int numRus, const std::vector<double>& snr, MacNodeId id = NODEID_NONE) override;
 
     LteFeedbackVector computeFeedback(const Remote remote, FeedbackType fbType,
             RbAllocationType rbAllocationType, TxMode currentTxMode,
             int antennaCws, int numPreferredBands, int numRus,
-            std::vector<double> snr, MacNodeId id = NODEID_NONE) override;
+            const std::vector<double>& snr, MacNodeId id = NODEID_NONE) override;
 
     LteFeedback computeFeedback(const Remote remote, TxMode txmode, FeedbackType fbType,
             RbAllocationType rbAllocationType,
             int antennaCws, int numPreferredBands, int numRus,
-            std::vector<double> snr, MacNodeId id = NODEID_NONE) override;
+            const std::vector<double>& snr, MacNodeId id = NODEID_NONE) override;
 };
 
 } //namespace
@@ -119,6 +119,14 @@ void ChannelAccess::sendToChannel(AirFrame *msg)
     cc->sendToChannel(myRadioRef, msg);
 }
 
+void ChannelAccess::sendToChannel(AirFrame *msg, const IChannelControl::ReceiverFilter& filter)
+{
+    EV << "sendToChannel: sending to the selected gates\n";
+
+    // delegate it to ChannelControl
+    cc->sendToChannel(myRadioRef, msg, filter);
+}
+
 void ChannelAccess::receiveSignal(cComponent *source, simsignal_t signalID, cObject *obj, cObject *)
 {
     // since background UEs and their mobility modules are submodules of the e/gNB, a mobilityStateChangedSignal
@@ -68,6 +68,9 @@ class ChannelAccess : public cSimpleModule, public cListener
     /** Sends a message to all radios in range */
     virtual void sendToChannel(AirFrame *msg);
 
+    /** Sends a message to the radios in range accepted by the filter */
+    virtual void sendToChannel(AirFrame *msg, const IChannelControl::ReceiverFilter& filter);
+
     virtual cPar& getChannelControlPar(const char *parName) { return check_and_cast<cModule *>(cc.get())->par(parName); }
     const inet::Coord& getRadioPosition() const { return radioPos; }
     cModule *getHostModule() const { return hostModule; }
@@ -16,6 +16,7 @@
 
 #include <cassert>
 #include <algorithm>
+#include <cmath>
 
 #include <inet/common/INETMath.h>
 
@@ -57,6 +58,9 @@ void ChannelControl::initialize(int stage)
         transmissions.resize(numChannels);
 
         maxInterferenceDistance = calcInterfDist();
+
+        // a non-positive or infinite interference distance degenerates to a single grid cell
+        gridCellSize = (std::isfinite(maxInterferenceDistance) && maxInterferenceDistance > 0) ? maxInterferenceDistance : 0;
     }
 }
 
@@ -111,39 +115,85 @@ ChannelControl::RadioRef ChannelControl::registerRadio(cModule *radio, cGate *ra
     re.isNeighborListValid = false;
     re.channel = 0;  // for now
     re.isActive = true;
+    re.cell = computeGridCell(re.pos);
     radios.push_back(re);
-    return &radios.back(); // last element
+
+    RadioRef newRadio = &radios.back(); // last element
+    radioIndex[radio] = newRadio;
+    grid[newRadio->cell].push_back(newRadio);
+    return newRadio;
 }
 
 void ChannelControl::unregisterRadio(RadioRef radio)
 {
     Enter_Method_Silent();
+    auto indexIt = radioIndex.find(radio->radioModule.get());
+    if (indexIt == radioIndex.end())
+        throw cRuntimeError("unregisterRadio failed: no such radio");
+
     auto radioIt = std::find_if(radios.begin(), radios.end(), [radio](const RadioEntry& r) {
-        return r.radioModule == radio->radioModule;
+        return &r == radio;
     });
+    ASSERT(radioIt != radios.end());
 
-    if (radioIt == radios.end())
-        throw cRuntimeError("unregisterRadio failed: no such radio");
-
-    // erase radio from all registered radios' neighbor list
+    // erase radio from its neighbors' neighbor list (the neighbor relation is symmetric)
     RadioRef radioToRemove = &(*radioIt);
-    for (auto & otherRadio : radios) {
-        otherRadio.neighbors.erase(radioToRemove);
-        otherRadio.isNeighborListValid = false;
-        radioToRemove->isNeighborListValid = false;
+    for (auto otherRadio : radioToRemove->neighbors) {
+        otherRadio->neighbors.erase(radioToRemove);
+        otherRadio->isNeighborListValid = false;
     }
 
-    // erase radio from registered radios
+    // erase radio from the lookup structures and from registered radios
+    removeFromGrid(radioToRemove);
+    radioIndex.erase(indexIt);
     radios.erase(radioIt);
 }
 
 ChannelControl::RadioRef ChannelControl::lookupRadio(cModule *radio)
 {
     Enter_Method_Silent();
-    for (auto & it : radios)
-        if (it.radioModule.get() == radio)
-            return &it;
-    return nullptr;
+    auto it = radioIndex.find(radio);
+    return it != radioIndex.end() ? it->second : nullptr;
+}
+
+GridCell ChannelControl::computeGridCell(const inet::Coord& pos) const
+{
+    GridCell cell;
+    if (gridCellSize <= 0)
+        return cell;
+
+    // clamp to keep the conversion to integer well defined for far-away (or invalid) positions
+    const double limit = 1e15;
+    cell.x = (int64_t)std::floor(std::clamp(pos.x / gridCellSize, -limit, limit));
+    cell.y = (int64_t)std::floor(std::clamp(pos.y / gridCellSize, -limit, limit));
+    return cell;
+}
+
+void ChannelControl::updateGridCell(RadioRef h)
+{
+    GridCell newCell = computeGridCell(h->pos);
+    if (newCell == h->cell)
+        return;
+
+    removeFromGrid(h);
+    h->cell = newCell;
+    grid[newCell].push_back(h);
+}
+
+void ChannelControl::removeFromGrid(RadioRef h)
+{
+    auto cellIt = grid.find(h->cell);
+    if (cellIt == grid.end())
+        return;
+
+    RadioRefVector& cellRadios = cellIt->second;
+    auto it = std::find(cellRadios.begin(), cellRadios.end(), h);
+    if (it != cellRadios.end()) {
+        *it = cellRadios.back();
+        cellRadios.pop_back();
+    }
+    if (cellRadios.empty())
+        grid.erase(cellIt);
 }
 
 const ChannelControl::RadioRefVector& ChannelControl::getNeighbors(RadioRef h)
@@ -162,27 +212,39 @@ void ChannelControl::updateConnections(RadioRef h)
 {
     inet::Coord& hpos = h->pos;
     double maxDistSquared = maxInterferenceDistance * maxInterferenceDistance;
-    for (auto & radio : radios) {
-        RadioEntry *hi = &radio;
-        if (hi == h)
-            continue;
 
-        // get the distance between the two radios.
-        // (omitting the square root (calling sqrdist() instead of distance()) saves about 5% CPU)
-        bool inRange = hpos.sqrdist(hi->pos) < maxDistSquared;
-
-        if (inRange) {
-            // nodes within communication range: connect
-            if (h->neighbors.insert(hi).second == true) {
-                hi->neighbors.insert(h);
-                h->isNeighborListValid = hi->isNeighborListValid = false;
-            }
+    // out of range: disconnect
+    // (only current neighbors need to be checked, wherever they are in the grid)
+    for (auto it = h->neighbors.begin(); it != h->neighbors.end(); ) {
+        RadioRef hi = *it;
+        // omitting the square root (calling sqrdist() instead of distance()) saves about 5% CPU
+        if (hpos.sqrdist(hi->pos) < maxDistSquared) {
+            ++it;
+            continue;
         }
-        else {
-            // out of range: disconnect
-            if (h->neighbors.erase(hi)) {
-                hi->neighbors.erase(h);
-                h->isNeighborListValid = hi->isNeighborListValid = false;
+        hi->neighbors.erase(h);
+        h->isNeighborListValid = hi->isNeighborListValid = false;
+        it = h->neighbors.erase(it);
+    }
+
+    // nodes within communication range: connect
+    // (only radios in the 3x3 block of grid cells around h can be in range)
+    updateGridCell(h);
+    int64_t cellSpan = (gridCellSize > 0) ? 1 : 0;
+    for (int64_t dx = -cellSpan; dx <= cellSpan; dx++) {
+        for (int64_t dy = -cellSpan; dy <= cellSpan; dy++) {
+            auto cellIt = grid.find({h->cell.x + dx, h->cell.y + dy});
+            if (cellIt == grid.end())
+                continue;
+
+            for (RadioRef hi : cellIt->second) {
+                if (hi == h || hpos.sqrdist(hi->pos) >= maxDistSquared)
+                    continue;
+
+                if (h->neighbors.insert(hi).second == true) {
+                    hi->neighbors.insert(h);
+                    h->isNeighborListValid = hi->isNeighborListValid = false;
+                }
             }
         }
     }
@@ -257,7 +319,7 @@ void ChannelControl::purgeOngoingTransmissions()
     }
 }
 
-void ChannelControl::sendToChannel(RadioRef srcRadio, AirFrame *airFrame)
+void ChannelControl::sendToChannel(RadioRef srcRadio, AirFrame *airFrame, const ReceiverFilter& filter)
 {
     // NOTE: no Enter_Method()! We pretend this method is part of ChannelAccess
 
@@ -271,6 +333,10 @@ void ChannelControl::sendToChannel(RadioRef srcRadio, AirFrame *airFrame)
             EV << "skipping disabled radio interface \n";
             continue;
         }
+        if (filter && !filter(r->radioModule.get())) {
+            EV << "skipping radio not interested in the frame\n";
+            continue;
+        }
         if (r->channel == channel) {
             EV << "sending message to radio listening on the same channel\n";
             // account for propagation delay, based on distance in meters
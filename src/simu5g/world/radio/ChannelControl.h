@@ -17,6 +17,7 @@
 #include <vector>
 #include <list>
 #include <set>
+#include <unordered_map>
 
 #include <inet/common/INETDefs.h>
 #include <inet/common/geometry/common/Coord.h>
@@ -32,6 +33,27 @@ class AirFrame;
 
 #define TRANSMISSION_PURGE_INTERVAL    1.0
 
+/**
+ * Cell of the uniform spatial grid used to find candidate neighbors.
+ * The side of each cell is not smaller than the maximum interference
+ * distance, hence all the radios in range of a given one lie within
+ * the 3x3 block of cells centered in the cell of that radio.
+ */
+struct GridCell {
+    int64_t x = 0;
+    int64_t y = 0;
+
+    bool operator==(const GridCell& other) const { return x == other.x && y == other.y; }
+};
+
+struct GridCellHash {
+    std::size_t operator()(const GridCell& cell) const {
+        std::size_t h1 = std::hash<int64_t>{}(cell.x);
+        std::size_t h2 = std::hash<int64_t>{}(cell.y);
+        return h1 ^ (h2 << 1);
+    }
+};
+
 /**
  * Keeps track of radios/NICs, their positions and channels;
  * also caches neighbor info (which other Radios are within
@@ -42,6 +64,7 @@ struct IChannelControl::RadioEntry {
     cGate *radioInGate = nullptr;  // gate on host module used to receive airframes
     int channel;
     inet::Coord pos; // cached radio position
+    GridCell cell; // grid cell the radio currently belongs to
 
     struct Compare {
         bool operator()(const RadioRef& lhs, const RadioRef& rhs) const {
@@ -72,6 +95,13 @@ class ChannelControl : public cSimpleModule, public IChannelControl
 
     RadioList radios;
 
+    /** index of the registered radios, keyed by the registering module */
+    std::unordered_map<const cModule *, RadioRef> radioIndex;
+
+    /** uniform spatial grid of the registered radios (cell side = gridCellSize) */
+    std::unordered_map<GridCell, RadioRefVector, GridCellHash> grid;
+    double gridCellSize = 0;
+
     /** keeps track of ongoing transmissions; this is needed when a radio
      * switches to another channel (then it needs to know whether the target channel
      * is empty or busy)
@@ -94,6 +124,15 @@ class ChannelControl : public cSimpleModule, public IChannelControl
   protected:
     virtual void updateConnections(RadioRef h);
 
+    /** Returns the grid cell containing the given position */
+    GridCell computeGridCell(const inet::Coord& pos) const;
+
+    /** Moves the radio to the grid cell corresponding to its current position */
+    void updateGridCell(RadioRef h);
+
+    /** Removes the radio from the grid */
+    void removeFromGrid(RadioRef h);
+
     /** Calculate interference distance*/
     virtual double calcInterfDist();
 
@@ -147,7 +186,10 @@ class ChannelControl : public cSimpleModule, public IChannelControl
     const TransmissionList& getOngoingTransmissions(int channel) override;
 
     /** Called from ChannelAccess, to transmit a frame to the radios in range, on the frame's channel */
-    void sendToChannel(RadioRef srcRadio, AirFrame *airFrame) override;
+    void sendToChannel(RadioRef srcRadio, AirFrame *airFrame) override { sendToChannel(srcRadio, airFrame, nullptr); }
+
+    /** Like sendToChannel(), but the frame is only delivered to the radios in range accepted by the filter */
+    void sendToChannel(RadioRef srcRadio, AirFrame *airFrame, const ReceiverFilter& filter) override;
 
     /** Returns the maximum interference distance*/
     double getInterferenceRange(RadioRef r) override { return maxInterferenceDistance; }
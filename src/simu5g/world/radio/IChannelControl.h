@@ -17,6 +17,7 @@
 #include <vector>
 #include <list>
 #include <set>
+#include <functional>
 
 #include <inet/common/INETDefs.h>
 #include <inet/common/geometry/common/Coord.h>
@@ -38,6 +39,8 @@ class IChannelControl
   public:
     typedef RadioEntry *RadioRef; // handle for ChannelControl's clients
     typedef std::list<AirFrame *> TransmissionList;
+    /** Tells whether a frame must be delivered to the given radio module */
+    typedef std::function<bool (cModule *)> ReceiverFilter;
 
   public:
 
@@ -71,6 +74,9 @@ class IChannelControl
     /** Called from ChannelAccess, to transmit a frame to the radios in range, on the frame's channel */
     virtual void sendToChannel(RadioRef srcRadio, AirFrame *airFrame) = 0;
 
+    /** Like sendToChannel(), but the frame is only delivered to the radios in range accepted by the filter */
+    virtual void sendToChannel(RadioRef srcRadio, AirFrame *airFrame, const ReceiverFilter& filter) = 0;
+
     /** Returns the maximal interference distance */
     virtual double getInterferenceRange(RadioRef r) = 0;
 
@@ -69,13 +69,17 @@ double LteChannelControl::calcInterfDist()
     return interfDistance;
 }
 
-void LteChannelControl::sendToChannel(RadioRef srcRadio, AirFrame *airFrame)
+void LteChannelControl::sendToChannel(RadioRef srcRadio, AirFrame *airFrame, const ReceiverFilter& filter)
 {
     // NOTE: no Enter_Method()! We pretend this method is part of ChannelAccess
 
     // Loop through all radios in range
     const RadioRefVector& neighbors = getNeighbors(srcRadio);
     for (auto r : neighbors) {
+        if (filter && !filter(r->radioModule.get())) {
+            coreEV << "skipping radio not interested in the frame\n";
+            continue;
+        }
         coreEV << "sending message to radio\n";
         simtime_t delay = 0.0;
         check_and_cast<cSimpleModule *>(srcRadio->radioModule.get())->sendDirect(airFrame->dup(), delay, airFrame->getDuration(), r->radioInGate);
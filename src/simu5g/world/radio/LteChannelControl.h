@@ -37,7 +37,8 @@ class LteChannelControl : public ChannelControl
   public:
 
     /** Called from ChannelAccess to transmit a frame to all the radios in range on the frame's channel */
-    void sendToChannel(RadioRef srcRadio, AirFrame *airFrame) override;
+    void sendToChannel(RadioRef srcRadio, AirFrame *airFrame) override { sendToChannel(srcRadio, airFrame, nullptr); }
+    void sendToChannel(RadioRef srcRadio, AirFrame *airFrame, const ReceiverFilter& filter) override;
 };
 
 } //namespace